@@ -0,0 +1,72 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// A thread which runs jobs for one I2C bus, so that the transfers on
+// different buses happen at the same time. run() hands a job over and
+// returns straight away, wait() returns once the job is done. There is only
+// one job at a time, and the caller must not touch what the job uses until
+// wait() has returned.
+class BusWorker
+{
+public:
+	BusWorker() : thread(&BusWorker::loop, this) {}
+	BusWorker(const BusWorker&) = delete;
+	BusWorker& operator=(const BusWorker&) = delete;
+	~BusWorker()
+	{
+		wait();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		cv.notify_all();
+		thread.join();
+	}
+	void run(std::function<void(void)> newJob)
+	{
+		wait();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = std::move(newJob);
+			busy = true;
+		}
+		cv.notify_all();
+	}
+	void wait()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		cv.wait(lock, [this]{ return !busy; });
+	}
+	// true while a job is running, without waiting for it
+	bool isBusy()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return busy;
+	}
+private:
+	void loop()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while(1)
+		{
+			cv.wait(lock, [this]{ return busy || stop; });
+			if(stop)
+				return;
+			lock.unlock();
+			job();
+			lock.lock();
+			job = nullptr;
+			busy = false;
+			cv.notify_all();
+		}
+	}
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::function<void(void)> job;
+	bool busy = false;
+	bool stop = false;
+	std::thread thread; // last, so that it starts once the rest is initialised
+};
@@ -0,0 +1,400 @@
+#pragma once
+#include <algorithm>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <memory>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+// Receives UDP datagrams in batches: it waits for the socket to become
+// readable and then drains it with a single recvmmsg() into preallocated
+// buffers, so that a burst of packets costs one syscall instead of one
+// per packet.
+// Packets which do not fit in a datagram can be sent over TCP or Unix domain
+// stream sockets instead: these are read in bounded chunks from the same
+// poll() so that a fast sender is held back by the socket buffer rather
+// than by an ever growing buffer here, and their packets are returned
+// together with the datagrams.
+// Replies can be sent back to where a packet came from with send().
+class OscBatchReceiver
+{
+public:
+	// where a packet came from
+	struct Peer {
+		unsigned int connection; // stream connection, 0 for UDP
+		sockaddr_in addr; // UDP sender
+		bool operator==(const Peer& other) const
+		{
+			if(connection || other.connection)
+				return connection == other.connection;
+			return addr.sin_addr.s_addr == other.addr.sin_addr.s_addr && addr.sin_port == other.addr.sin_port;
+		}
+	};
+	struct Packet {
+		const char* data;
+		size_t size;
+		const char* from; // IP address of the sender, or "unix"
+		Peer peer;
+	};
+	enum Framing {
+		kFramingSlip, // OSC 1.1: each packet is followed by a SLIP END byte
+		kFramingLength, // OSC 1.0: each packet is preceded by its size as a big-endian int32
+	};
+	static constexpr unsigned int kMaxPackets = 64;
+	static constexpr unsigned int kMaxPacketSize = 8192;
+	static constexpr size_t kMaxStreamPacketSize = 1 << 20;
+	static constexpr size_t kStreamReadSize = 65536; // per connection per receive()
+
+	OscBatchReceiver() {};
+	OscBatchReceiver(const OscBatchReceiver&) = delete;
+	OscBatchReceiver& operator=(const OscBatchReceiver&) = delete;
+	~OscBatchReceiver()
+	{
+		if(fd >= 0)
+			close(fd);
+		for(auto& l : listeners)
+		{
+			close(l.fd);
+			if(l.path.size())
+				unlink(l.path.c_str());
+		}
+		for(auto& c : connections)
+		{
+			if(c->fd >= 0)
+				close(c->fd);
+		}
+	}
+	int setup(int port)
+	{
+		fd = socket(AF_INET, SOCK_DGRAM, 0);
+		if(fd < 0)
+		{
+			fprintf(stderr, "Unable to create UDP socket: %s\n", strerror(errno));
+			return -1;
+		}
+		sockaddr_in addr = {};
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_ANY);
+		addr.sin_port = htons(port);
+		if(bind(fd, (sockaddr*)&addr, sizeof(addr)))
+		{
+			fprintf(stderr, "Unable to bind UDP port %d: %s\n", port, strerror(errno));
+			return -1;
+		}
+		buffer.resize(kMaxPackets * kMaxPacketSize);
+		iovecs.resize(kMaxPackets);
+		msgs.resize(kMaxPackets);
+		addrs.resize(kMaxPackets);
+		froms.resize(kMaxPackets);
+		packets.reserve(kMaxPackets);
+		for(unsigned int n = 0; n < kMaxPackets; ++n)
+		{
+			iovecs[n] = {buffer.data() + n * kMaxPacketSize, kMaxPacketSize};
+			msgs[n].msg_hdr.msg_iov = &iovecs[n];
+			msgs[n].msg_hdr.msg_iovlen = 1;
+			msgs[n].msg_hdr.msg_name = &addrs[n];
+		}
+		return 0;
+	}
+	// also accept OSC over TCP connections on port
+	int setupTcp(int port, Framing framing)
+	{
+		int lfd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if(lfd < 0)
+		{
+			fprintf(stderr, "Unable to create TCP socket: %s\n", strerror(errno));
+			return -1;
+		}
+		int one = 1;
+		setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+		sockaddr_in addr = {};
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_ANY);
+		addr.sin_port = htons(port);
+		if(bind(lfd, (sockaddr*)&addr, sizeof(addr)) || listen(lfd, 8))
+		{
+			fprintf(stderr, "Unable to listen on TCP port %d: %s\n", port, strerror(errno));
+			close(lfd);
+			return -1;
+		}
+		listeners.push_back({lfd, framing, ""});
+		return 0;
+	}
+	// also accept OSC over Unix domain stream connections on path
+	int setupUnix(const char* path, Framing framing)
+	{
+		sockaddr_un addr = {};
+		addr.sun_family = AF_UNIX;
+		if(strlen(path) >= sizeof(addr.sun_path))
+		{
+			fprintf(stderr, "Socket path too long: %s\n", path);
+			return -1;
+		}
+		strcpy(addr.sun_path, path);
+		int lfd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if(lfd < 0)
+		{
+			fprintf(stderr, "Unable to create Unix socket: %s\n", strerror(errno));
+			return -1;
+		}
+		unlink(path); // left behind by a previous run
+		if(bind(lfd, (sockaddr*)&addr, sizeof(addr)) || listen(lfd, 8))
+		{
+			fprintf(stderr, "Unable to listen on %s: %s\n", path, strerror(errno));
+			close(lfd);
+			return -1;
+		}
+		listeners.push_back({lfd, framing, path});
+		return 0;
+	}
+	// Wait up to timeoutMs for datagrams or stream data, then read all the
+	// datagrams that are already queued, up to kMaxPackets, and up to
+	// kStreamReadSize bytes from each connection. The packets are valid
+	// until the next call.
+	const std::vector<Packet>& receive(int timeoutMs)
+	{
+		packets.clear();
+		// release what was returned by the previous call
+		for(size_t n = 0; n < connections.size(); )
+		{
+			Connection& c = *connections[n];
+			if(c.fd < 0)
+			{
+				connections.erase(connections.begin() + n);
+				continue;
+			}
+			c.buffer.erase(c.buffer.begin(), c.buffer.begin() + c.consumed);
+			c.consumed = 0;
+			++n;
+		}
+		pfds.resize(1 + listeners.size() + connections.size());
+		pfds[0] = {fd, POLLIN, 0};
+		for(size_t n = 0; n < listeners.size(); ++n)
+			pfds[1 + n] = {listeners[n].fd, POLLIN, 0};
+		for(size_t n = 0; n < connections.size(); ++n)
+			pfds[1 + listeners.size() + n] = {connections[n]->fd, POLLIN, 0};
+		if(poll(pfds.data(), pfds.size(), timeoutMs) <= 0)
+			return packets;
+		if(pfds[0].revents)
+			receiveDatagrams();
+		// only the connections polled above are read, before new ones are
+		// added. Packets point into the connections, which are allocated one
+		// by one so that they stay in place when more are added
+		size_t nConnections = connections.size();
+		for(size_t n = 0; n < nConnections; ++n)
+		{
+			if(pfds[1 + listeners.size() + n].revents)
+				receiveStream(*connections[n]);
+		}
+		for(size_t n = 0; n < listeners.size(); ++n)
+		{
+			if(pfds[1 + n].revents)
+				accept(listeners[n]);
+		}
+		return packets;
+	}
+	// Send a packet to peer without blocking. Returns false if it could not
+	// be sent: a stream connection which cannot take a whole packet is
+	// closed, as its framing would be lost.
+	bool send(const Peer& peer, const char* data, size_t size)
+	{
+		if(!peer.connection)
+			return sendto(fd, data, size, MSG_DONTWAIT, (const sockaddr*)&peer.addr, sizeof(peer.addr)) == ssize_t(size);
+		Connection* c = findConnection(peer.connection);
+		if(!c)
+			return false;
+		sendBuffer.clear();
+		if(kFramingSlip == c->framing)
+		{
+			sendBuffer.push_back(char(0xc0));
+			for(size_t n = 0; n < size; ++n)
+			{
+				if(char(0xc0) == data[n])
+					sendBuffer.insert(sendBuffer.end(), {char(0xdb), char(0xdc)});
+				else if(char(0xdb) == data[n])
+					sendBuffer.insert(sendBuffer.end(), {char(0xdb), char(0xdd)});
+				else
+					sendBuffer.push_back(data[n]);
+			}
+			sendBuffer.push_back(char(0xc0));
+		} else {
+			uint32_t packetSize = htonl(size);
+			sendBuffer.insert(sendBuffer.end(), (const char*)&packetSize, (const char*)&packetSize + sizeof(packetSize));
+			sendBuffer.insert(sendBuffer.end(), data, data + size);
+		}
+		if(::send(c->fd, sendBuffer.data(), sendBuffer.size(), MSG_DONTWAIT | MSG_NOSIGNAL) != ssize_t(sendBuffer.size()))
+		{
+			fprintf(stderr, "Unable to send to %s, closing the connection\n", c->from.str);
+			closeConnection(*c);
+			return false;
+		}
+		return true;
+	}
+	bool isConnected(const Peer& peer)
+	{
+		return !peer.connection || findConnection(peer.connection);
+	}
+	// bytes received on the stream connections which have not been
+	// returned as packets yet, including those still in the socket buffers
+	size_t getQueuedBytes()
+	{
+		size_t bytes = 0;
+		for(auto& c : connections)
+		{
+			int queued = 0;
+			if(c->fd >= 0 && !ioctl(c->fd, FIONREAD, &queued))
+				bytes += c->buffer.size() - c->consumed + queued;
+		}
+		return bytes;
+	}
+private:
+	struct From {
+		char str[INET_ADDRSTRLEN];
+	};
+	struct Listener {
+		int fd;
+		Framing framing;
+		std::string path; // empty for TCP
+	};
+	struct Connection {
+		int fd;
+		unsigned int id;
+		Framing framing;
+		From from;
+		std::vector<char> buffer;
+		size_t consumed; // bytes of buffer already returned as packets
+	};
+	void receiveDatagrams()
+	{
+		for(auto& msg : msgs)
+		{
+			msg.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			msg.msg_hdr.msg_flags = 0;
+		}
+		int count = recvmmsg(fd, msgs.data(), msgs.size(), MSG_DONTWAIT, nullptr);
+		for(int n = 0; n < count; ++n)
+		{
+			if(msgs[n].msg_hdr.msg_flags & MSG_TRUNC)
+			{
+				fprintf(stderr, "Dropping a datagram larger than %u bytes\n", kMaxPacketSize);
+				continue;
+			}
+			inet_ntop(AF_INET, &addrs[n].sin_addr, froms[n].str, sizeof(froms[n].str));
+			packets.push_back({(const char*)iovecs[n].iov_base, msgs[n].msg_len, froms[n].str, {0, addrs[n]}});
+		}
+	}
+	void accept(const Listener& l)
+	{
+		int cfd;
+		sockaddr_in addr;
+		socklen_t len = sizeof(addr);
+		while((cfd = accept4(l.fd, (sockaddr*)&addr, &len, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+		{
+			connections.push_back(std::unique_ptr<Connection>(new Connection{cfd, ++lastConnectionId, l.framing, {"unix"}, {}, 0}));
+			Connection& c = *connections.back();
+			if(l.path.empty())
+				inet_ntop(AF_INET, &addr.sin_addr, c.from.str, sizeof(c.from.str));
+			printf("OSC stream connection from %s\n", c.from.str);
+			len = sizeof(addr);
+		}
+	}
+	Connection* findConnection(unsigned int id)
+	{
+		for(auto& c : connections)
+		{
+			if(id == c->id && c->fd >= 0)
+				return c.get();
+		}
+		return nullptr;
+	}
+	void closeConnection(Connection& c)
+	{
+		close(c.fd);
+		c.fd = -1; // removed on the next receive(), its packets are still in use
+	}
+	void receiveStream(Connection& c)
+	{
+		size_t size = c.buffer.size();
+		c.buffer.resize(size + kStreamReadSize);
+		ssize_t ret = read(c.fd, c.buffer.data() + size, kStreamReadSize);
+		c.buffer.resize(size + std::max(ret, ssize_t(0)));
+		if(0 == ret || (ret < 0 && EAGAIN != errno && EINTR != errno))
+		{
+			if(ret < 0)
+				fprintf(stderr, "Error reading from %s: %s\n", c.from.str, strerror(errno));
+			if(c.buffer.size() != c.consumed)
+				fprintf(stderr, "Dropping an incomplete packet from %s\n", c.from.str);
+			closeConnection(c);
+			return;
+		}
+		char* p = c.buffer.data() + c.consumed;
+		char* end = c.buffer.data() + c.buffer.size();
+		bool tooLarge = false;
+		if(kFramingSlip == c.framing)
+		{
+			const char kEnd = char(0xc0);
+			const char kEsc = char(0xdb);
+			char* frameEnd;
+			while((frameEnd = (char*)memchr(p, kEnd, end - p)))
+			{
+				// decode in place: the packet can only be shorter
+				char* out = p;
+				for(char* in = p; in < frameEnd; ++in)
+				{
+					if(kEsc == *in && in + 1 < frameEnd)
+					{
+						++in;
+						*out++ = char(0xdc) == *in ? kEnd : char(0xdd) == *in ? kEsc : *in;
+					} else
+						*out++ = *in;
+				}
+				if(out != p) // empty frames are allowed between packets
+					packets.push_back({p, size_t(out - p), c.from.str, {c.id, {}}});
+				p = frameEnd + 1;
+			}
+		} else {
+			while(end - p >= 4)
+			{
+				uint32_t packetSize;
+				memcpy(&packetSize, p, sizeof(packetSize));
+				packetSize = ntohl(packetSize);
+				if(packetSize > kMaxStreamPacketSize)
+				{
+					tooLarge = true;
+					break;
+				}
+				if(size_t(end - p) - 4 < packetSize)
+					break;
+				if(packetSize)
+					packets.push_back({p + 4, packetSize, c.from.str, {c.id, {}}});
+				p += 4 + packetSize;
+			}
+		}
+		c.consumed = p - c.buffer.data();
+		if(tooLarge || c.buffer.size() - c.consumed > kMaxStreamPacketSize + 4)
+		{
+			fprintf(stderr, "Packet from %s larger than %zu bytes, closing the connection\n", c.from.str, kMaxStreamPacketSize);
+			closeConnection(c);
+		}
+	}
+	int fd = -1;
+	std::vector<char> buffer;
+	std::vector<iovec> iovecs;
+	std::vector<mmsghdr> msgs;
+	std::vector<sockaddr_in> addrs;
+	std::vector<From> froms;
+	std::vector<Packet> packets;
+	std::vector<Listener> listeners;
+	std::vector<std::unique_ptr<Connection>> connections;
+	std::vector<pollfd> pfds;
+	std::vector<char> sendBuffer;
+	unsigned int lastConnectionId = 0;
+};
@@ -0,0 +1,405 @@
+#pragma once
+#include <arpa/inet.h>
+#include <endian.h>
+#include <ostream>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+// A string inside a received OSC packet. OSC strings are null-terminated in
+// the packet, so c_str() can be used without copying them.
+class OscStringView
+{
+public:
+	OscStringView() {};
+	OscStringView(const char* data, size_t size) : ptr(data), len(size) {};
+	const char* c_str() const { return ptr; }
+	const char* data() const { return ptr; }
+	size_t size() const { return len; }
+	bool empty() const { return !len; }
+	char operator[](size_t n) const { return ptr[n]; }
+	std::string str() const { return std::string(ptr, len); }
+	bool operator==(const OscStringView& other) const
+	{
+		return len == other.len && !memcmp(ptr, other.ptr, len);
+	}
+	bool operator!=(const OscStringView& other) const { return !(*this == other); }
+	bool operator==(const char* other) const
+	{
+		return !strncmp(ptr, other, len) && !other[len];
+	}
+	friend bool operator==(const char* a, const OscStringView& b) { return b == a; }
+	friend std::ostream& operator<<(std::ostream& out, const OscStringView& str)
+	{
+		return out.write(str.ptr, str.len);
+	}
+private:
+	const char* ptr = "";
+	size_t len = 0;
+};
+
+// An OSC message decoded in place in the packet it was received in. The type
+// tags and the sizes of all arguments are checked once by init(), then the
+// arguments are read straight from the packet as they are popped: nothing is
+// copied and the message is only valid as long as the packet is.
+// The interface follows oscpkt::Message.
+class OscMessageView
+{
+public:
+	struct Blob {
+		const char* data;
+		size_t size;
+	};
+	class ArgReader
+	{
+	public:
+		ArgReader(const char* tags, size_t nTags, const char* args) : tag(tags), tagEnd(tags + nTags), arg(args) {};
+		size_t nbArgRemaining() const { return tagEnd - tag; }
+		bool isOk() const { return ok; }
+		bool isOkNoMoreArgs() const { return ok && tag == tagEnd; }
+		explicit operator bool() const { return ok; }
+		bool isInt32() const { return 'i' == current(); }
+		bool isInt64() const { return 'h' == current(); }
+		bool isFloat() const { return 'f' == current(); }
+		bool isDouble() const { return 'd' == current(); }
+		bool isBool() const { return 'T' == current() || 'F' == current(); }
+		bool isStr() const { return 's' == current(); }
+		bool isBlob() const { return 'b' == current(); }
+		bool isNumber() const { return isInt32() || isInt64() || isFloat() || isDouble(); }
+		ArgReader& popInt32(int32_t& value)
+		{
+			if(pop('i'))
+			{
+				value = read32(arg);
+				arg += 4;
+			}
+			return *this;
+		}
+		ArgReader& popInt64(int64_t& value)
+		{
+			if(pop('h'))
+			{
+				value = read64(arg);
+				arg += 8;
+			}
+			return *this;
+		}
+		ArgReader& popFloat(float& value)
+		{
+			if(pop('f'))
+			{
+				value = readFloat(arg);
+				arg += 4;
+			}
+			return *this;
+		}
+		ArgReader& popDouble(double& value)
+		{
+			if(pop('d'))
+			{
+				value = readDouble(arg);
+				arg += 8;
+			}
+			return *this;
+		}
+		ArgReader& popBool(bool& value)
+		{
+			if(isBool())
+				value = 'T' == *tag++;
+			else
+				ok = false;
+			return *this;
+		}
+		ArgReader& popStr(OscStringView& value)
+		{
+			if(pop('s'))
+			{
+				size_t len = strlen(arg);
+				value = OscStringView(arg, len);
+				arg += padded(len + 1);
+			}
+			return *this;
+		}
+		ArgReader& popBlob(Blob& value)
+		{
+			if(pop('b'))
+			{
+				value = {arg + 4, read32(arg)};
+				arg += 4 + padded(value.size);
+			}
+			return *this;
+		}
+		// pops any numeric argument, converted to T
+		template <typename T> ArgReader& popNumber(T& value)
+		{
+			switch(current())
+			{
+			case 'i':
+				value = T(int32_t(read32(arg)));
+				arg += 4;
+				break;
+			case 'h':
+				value = T(int64_t(read64(arg)));
+				arg += 8;
+				break;
+			case 'f':
+				value = T(readFloat(arg));
+				arg += 4;
+				break;
+			case 'd':
+				value = T(readDouble(arg));
+				arg += 8;
+				break;
+			default:
+				ok = false;
+				return *this;
+			}
+			++tag;
+			return *this;
+		}
+	private:
+		char current() const { return ok && tag != tagEnd ? *tag : 0; }
+		bool pop(char type)
+		{
+			if(current() != type)
+			{
+				ok = false;
+				return false;
+			}
+			++tag;
+			return true;
+		}
+		const char* tag;
+		const char* tagEnd;
+		const char* arg;
+		bool ok = true;
+	};
+
+	// returns false if data is not a well-formed OSC message
+	bool init(const char* data, size_t size)
+	{
+		const char* p = data;
+		const char* end = data + size;
+		if(!popString(p, end, address) || '/' != address[0])
+			return false;
+		hasWildcards = strpbrk(address.c_str(), "*?[{");
+		tags = "";
+		nTags = 0;
+		args = p;
+		if(p == end)
+			return true; // no type tags: no arguments
+		OscStringView tagString;
+		if(!popString(p, end, tagString) || ',' != tagString[0])
+			return false;
+		tags = tagString.c_str() + 1;
+		nTags = tagString.size() - 1;
+		args = p;
+		for(size_t n = 0; n < nTags; ++n)
+		{
+			size_t argSize;
+			switch(tags[n])
+			{
+			case 'T':
+			case 'F':
+				argSize = 0;
+				break;
+			case 'i':
+			case 'f':
+				argSize = 4;
+				break;
+			case 'h':
+			case 'd':
+				argSize = 8;
+				break;
+			case 's':
+			{
+				OscStringView str;
+				if(!popString(p, end, str))
+					return false;
+				continue;
+			}
+			case 'b':
+				if(end - p < 4 || read32(p) > size_t(end - p) - 4)
+					return false;
+				argSize = 4 + padded(read32(p));
+				break;
+			default:
+				return false;
+			}
+			if(argSize > size_t(end - p))
+				return false;
+			p += argSize;
+		}
+		return p == end;
+	}
+	const OscStringView& addressPattern() const { return address; }
+	ArgReader arg() const { return ArgReader(tags, nTags, args); }
+	// true if the address pattern of the message matches test
+	bool match(const char* test) const
+	{
+		if(!hasWildcards)
+			return address == test;
+		return matchPattern(address.data(), address.data() + address.size(), test, false);
+	}
+	// true if the address pattern of the message starts with test
+	bool partialMatch(const char* test) const
+	{
+		if(!hasWildcards)
+		{
+			size_t len = strlen(test);
+			return address.size() >= len && !memcmp(address.data(), test, len);
+		}
+		return matchPattern(address.data(), address.data() + address.size(), test, true);
+	}
+
+	// calls onMessage(const OscMessageView&) for each of the messages in a
+	// packet, including those in (nested) bundles, in order. Returns false if
+	// the packet is malformed, possibly after some messages have been passed
+	// on.
+	template <typename F>
+	static bool parsePacket(const char* data, size_t size, F&& onMessage)
+	{
+		if(size >= 8 && !memcmp(data, "#bundle", 8))
+		{
+			// "#bundle", time tag, then elements each preceded by its size
+			if(size < 16)
+				return false;
+			const char* p = data + 16;
+			const char* end = data + size;
+			while(p != end)
+			{
+				if(end - p < 4)
+					return false;
+				size_t elementSize = read32(p);
+				p += 4;
+				if(elementSize > size_t(end - p) || elementSize % 4)
+					return false;
+				if(!parsePacket(p, elementSize, onMessage))
+					return false;
+				p += elementSize;
+			}
+			return true;
+		}
+		OscMessageView msg;
+		if(!msg.init(data, size))
+			return false;
+		onMessage(msg);
+		return true;
+	}
+private:
+	static size_t padded(size_t size) { return (size + 3) & ~size_t(3); }
+	// OSC numbers are big endian and arguments are not necessarily aligned
+	static uint32_t read32(const char* p)
+	{
+		uint32_t value;
+		memcpy(&value, p, sizeof(value));
+		return ntohl(value);
+	}
+	static uint64_t read64(const char* p)
+	{
+		uint64_t value;
+		memcpy(&value, p, sizeof(value));
+		return be64toh(value);
+	}
+	static float readFloat(const char* p)
+	{
+		uint32_t bits = read32(p);
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+	static double readDouble(const char* p)
+	{
+		uint64_t bits = read64(p);
+		double value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+	// a null-terminated string padded to a multiple of 4 bytes
+	static bool popString(const char*& p, const char* end, OscStringView& str)
+	{
+		const char* nul = (const char*)memchr(p, 0, end - p);
+		if(!nul || padded(nul - p + 1) > size_t(end - p))
+			return false;
+		str = OscStringView(p, nul - p);
+		p += padded(nul - p + 1);
+		return true;
+	}
+	// matches an OSC address pattern with wildcards (?, *, [] and {}) against
+	// a null-terminated address. If partial, the pattern only has to match the
+	// beginning of the address
+	static bool matchPattern(const char* p, const char* pe, const char* t, bool partial)
+	{
+		while(p != pe)
+		{
+			if(!*t)
+				return partial;
+			switch(*p)
+			{
+			case '?':
+				if('/' == *t)
+					return false;
+				break;
+			case '*':
+				// any sequence of characters within the same address part
+				for(++p; ; ++t)
+				{
+					if(matchPattern(p, pe, t, partial))
+						return true;
+					if(!*t || '/' == *t)
+						return false;
+				}
+			case '[':
+			{
+				const char* close = (const char*)memchr(p, ']', pe - p);
+				if(!close)
+					return false;
+				bool negate = '!' == p[1];
+				bool found = false;
+				for(const char* c = p + 1 + negate; c < close; ++c)
+				{
+					if(c + 2 < close && '-' == c[1])
+					{
+						found |= *t >= c[0] && *t <= c[2];
+						c += 2;
+					} else
+						found |= *c == *t;
+				}
+				if(found == negate)
+					return false;
+				p = close;
+				break;
+			}
+			case '{':
+			{
+				const char* close = (const char*)memchr(p, '}', pe - p);
+				if(!close)
+					return false;
+				for(const char* alt = p + 1; alt <= close; )
+				{
+					const char* altEnd = alt;
+					while(altEnd < close && ',' != *altEnd)
+						++altEnd;
+					size_t len = altEnd - alt;
+					if(!strncmp(alt, t, len) && matchPattern(close + 1, pe, t + len, partial))
+						return true;
+					alt = altEnd + 1;
+				}
+				return false;
+			}
+			default:
+				if(*p != *t)
+					return false;
+			}
+			++p;
+			++t;
+		}
+		return !*t;
+	}
+
+	OscStringView address;
+	const char* tags = "";
+	size_t nTags = 0;
+	const char* args = nullptr;
+	bool hasWildcards = false;
+};
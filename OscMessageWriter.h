@@ -0,0 +1,64 @@
+#pragma once
+#include <arpa/inet.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+// Builds an OSC message into a buffer which is reused from one message to
+// the next. The interface follows oscpkt::Message.
+class OscMessageWriter
+{
+public:
+	OscMessageWriter& init(const char* address)
+	{
+		packet.clear();
+		pushString(packet, address);
+		tags = ",";
+		args.clear();
+		return *this;
+	}
+	OscMessageWriter& pushInt32(int32_t value)
+	{
+		tags.push_back('i');
+		push32(uint32_t(value));
+		return *this;
+	}
+	OscMessageWriter& pushFloat(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		tags.push_back('f');
+		push32(bits);
+		return *this;
+	}
+	OscMessageWriter& pushStr(const char* value)
+	{
+		tags.push_back('s');
+		pushString(args, value);
+		return *this;
+	}
+	// the encoded message, valid until the writer is changed
+	const std::string& data()
+	{
+		packet.resize(padded(strlen(packet.c_str()) + 1));
+		pushString(packet, tags.c_str());
+		packet += args;
+		return packet;
+	}
+private:
+	static size_t padded(size_t size) { return (size + 3) & ~size_t(3); }
+	static void pushString(std::string& out, const char* str)
+	{
+		size_t len = strlen(str);
+		out.append(str, len);
+		out.resize(out.size() + padded(len + 1) - len, '\0');
+	}
+	void push32(uint32_t value)
+	{
+		value = htonl(value);
+		args.append((const char*)&value, sizeof(value));
+	}
+	std::string packet; // address, then the whole message
+	std::string tags;
+	std::string args;
+};
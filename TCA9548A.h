@@ -13,9 +13,26 @@ public:
 			throw std::runtime_error("Unable to open TCA9548A. Ensure the multiplexer is connected"
 			"and the bus and address are correct.");
 	}
+	// enable channel (0 to 7), or disable all channels if it is out of range.
+	// The mux is only written to when the channel changes
 	int select(int channel)
 	{
-		i2c_char_t byte = channel < 0 || channel >= 8 ? 0 : 1 << channel;
-		return (sizeof(byte) != write(i2C_file, &byte, sizeof(byte)));
+		if(channel < 0 || channel >= 8)
+			channel = -1;
+		if(channel == current)
+			return 0;
+		i2c_char_t byte = -1 == channel ? 0 : 1 << channel;
+		if(sizeof(byte) != write(i2C_file, &byte, sizeof(byte)))
+		{
+			current = kUnknown;
+			return 1;
+		}
+		current = channel;
+		return 0;
 	}
+	// the selected channel, -1 if none, kUnknown before it is known
+	int getChannel() const { return current; }
+private:
+	static constexpr int kUnknown = -2; // before the first write, or after a failed one
+	int current = kUnknown;
 };
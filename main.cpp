@@ -89,48 +89,204 @@ times a second.
 */
 
 #include <signal.h>
-#include <libraries/OscReceiver/OscReceiver.h>
+#include "OscBatchReceiver.h"
+#include "OscMessageView.h"
+#include "OscMessageWriter.h"
+#include "BusWorker.h"
+#include "TCA9548A.h"
 #include <unistd.h>
 #include "u8g2/U8g2LinuxI2C.h"
+#include "u8g2/cppsrc/MUIU8g2.h"
 #include <vector>
 #include <algorithm>
+#include <climits>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
 #include <MiscUtilities.h>
-#include <mutex>
+#include <chrono>
+#include <stdint.h>
 
-std::mutex mtx;
 std::vector<bool> gShouldSend;
 
-const unsigned int gI2cBus = 1;
+const unsigned int gI2cBus = 1; // the bus of the displays and muxes below
 
-// #define I2C_MUX // allow I2C multiplexing to select different target displays
-struct Display {U8G2 d; int mux;};
+// TCA9548A I2C multiplexers. A mux is either on a bus or behind a channel of
+// another mux (cascaded), which has to be listed before it.
+struct Mux {
+	unsigned int bus;
+	unsigned int address;
+	int parent; // index in gMuxes of the mux this one is behind, -1 if it is directly on the bus
+	int channel; // the channel of parent this one is behind
+	TCA9548A tca;
+};
+std::vector<Mux> gMuxes = {
+	// e.g. one mux on each bus, and a second one behind channel 7 of the first:
+	// { gI2cBus, 0x70, -1, 0 }, // mux 0
+	// { 2, 0x70, -1, 0 }, // mux 1
+	// { gI2cBus, 0x71, 0, 7 }, // mux 2
+};
+// Effects which are done by the display controller itself (contrast, inverse
+// display, entire display on, display off). They cost a few command bytes
+// each and never redraw or resend the framebuffer.
+struct Effects {
+	float contrast = 1; // 0 to 1
+	float fadeFrom = 1;
+	float fadeTo = 1;
+	uint64_t fadeStart = 0;
+	uint64_t fadeEnd = 0; // 0 when no fade is running
+	int sentContrast = 255; // the display is set to this at startup
+	uint64_t invertEnd = 0; // 0 when not inverted
+	uint64_t flashEnd = 0; // 0 when not flashing
+	uint8_t sentPixelMode = U8X8_PIXEL_MODE_NORMAL;
+	uint64_t blinkInterval = 0; // 0 when not blinking
+	uint64_t nextBlink = 0;
+	bool blinkOff = false;
+};
+// text console filled by /log
+struct Log {
+	U8G2LOG log;
+	std::vector<uint8_t> screen; // empty until the first /log
+	bool isShown = false; // the buffer of the display contains the log and nothing else
+};
+// MUI forms loaded with /mui/form. Besides styles (S0: 5x8, S1: ncenB08,
+// S2: 4x6), labels and goto buttons the forms can use these fields, each of
+// them with its own variable, which is set with /mui/value:
+// N0..N7: number 0-255, B0..B7: bar 0-100, C0..C7: checkbox, O0..O7: option line
+const char kMenuValueKinds[] = "NBCO";
+const unsigned int kMenuValuesPerKind = 8;
+struct Menu {
+	MUIU8G2 mui;
+	std::string fds; // form definition, empty until the first /mui/form
+	std::vector<muif_struct> muif; // field functions, pointing into the vectors below
+	std::vector<mui_u8g2_u8_min_max_struct> numbers;
+	std::vector<mui_u8g2_u8_min_max_step_struct> bars;
+	std::vector<uint8_t> values;
+	mui_u8g2_form_areas_t areas = {}; // where each field is in the buffer
+	bool isShown = false; // the buffer of the display contains the form and nothing else
+};
+// Once a display has been drawn to, it should be sent before its deadline,
+// 1/fps after that. The buses are shared one page (8 pixel rows) at a time,
+// see getNextFlush(): if a bus cannot keep up, displays with a higher
+// priority keep their deadlines at the expense of those with a lower one.
+enum {
+	kPriorityLow = -1,
+	kPriorityNormal = 0,
+	kPriorityCritical = 1,
+};
+const float gDefaultFps = 30; // for displays with an fps of 0
+// a frame being sent to a display
+struct Flush {
+	uint8_t pages = 0; // 0 when there is nothing to send
+	uint8_t nextPage = 0;
+	uint8_t remaining = 0; // pages to go through. If the display is drawn to
+	// before they are all sent, the frame ends and a new one starts from
+	// nextPage, for as many pages as the display has
+	bool done = false; // sent, to be reported by the main thread
+	uint64_t deadline = 0;
+	uint64_t renderUs = 0; // spent drawing the content of the frame
+	uint64_t busUs = 0;
+};
+struct Display {
+	U8G2LinuxI2C d;
+	int mux; // index in gMuxes, -1 if the display is directly on the bus
+	int channel = 0; // the channel of mux the display is behind
+	int priority = kPriorityNormal;
+	float fps = 0;
+	std::vector<float> plotSamples = {};
+	Effects effects = {};
+	Log log = {};
+	Menu menu = {};
+	uint32_t frameSeq = 0; // the frames which have ended
+	uint64_t renderUs = 0; // spent drawing since the last frame started
+	unsigned int bus = 0; // index in gBuses, set in main()
+	Flush flush = {};
+	unsigned int missed = 0; // frames which ended after their deadline since they were last reported
+};
 std::vector<Display> gDisplays = {
-	// use `-1` as the last value to indicate that the display is not behind a mux, or a number between 0 and 7 for its muxed channel number
+	// the display is followed by `-1` if it is not behind a mux, or by the
+	// index of its mux in gMuxes and the channel (0 to 7), then optionally
+	// its priority and fps, e.g.
+	// { U8G2_SH1106_128X64_NONAME_F_HW_I2C_LINUX(U8G2_R0, gI2cBus, 0x3c), 2, 5, kPriorityCritical, 60},
 	{ U8G2_SH1106_128X64_NONAME_F_HW_I2C_LINUX(U8G2_R0, gI2cBus, 0x3c), -1},
+	// 16 level grayscale display, e.g.:
+	// { U8G2_SSD1327_MIDAS_128X128_F_HW_I2C_LINUX(U8G2_R0, gI2cBus, 0x3d), -1},
+	// a canvas which is not a display itself, but is split into the panels of
+	// a video wall (see gPanels), with its size in tiles of 8x8 pixels, e.g. 512x64:
+	// { U8G2LinuxI2C(U8G2_R0, 64, 8), -1},
 	// add more displays / addresses here
 };
+// The panels of video walls: messages to a canvas in gDisplays are drawn to
+// its buffer, which is copied into the panels when it is sent. Only the panels
+// whose content has changed are sent. A panel shows the area of the canvas
+// starting at x,y (multiples of 8), with the size and rotation of its display.
+// Panels can still be drawn to on their own until the canvas changes again.
+struct Panel {
+	unsigned int wall; // index in gDisplays of the canvas
+	unsigned int display; // index in gDisplays of the panel
+	unsigned int x;
+	unsigned int y;
+};
+std::vector<Panel> gPanels = {
+	// e.g. four 128x64 displays side by side on the 512x64 canvas above:
+	// { 4, 0, 0, 0 }, { 4, 1, 128, 0 }, { 4, 2, 256, 0 }, { 4, 3, 384, 0 },
+};
 
-unsigned int gActiveTarget = 0;
+unsigned int gActiveTarget = 0; // the display the current message draws to
 const int gLocalPort = 7562; //port for incoming OSC messages
+// stream transports for packets which do not fit in a datagram (large
+// /waveform or /mui/form messages). 0 or nullptr to disable
+const int gLocalStreamPort = 7562; // TCP
+const char* gLocalSocketPath = "/tmp/o2o-osc.sock"; // Unix domain socket
+// OSC 1.0 framing, as used by e.g. SuperCollider's NetAddr.connect
+const OscBatchReceiver::Framing gStreamFraming = OscBatchReceiver::kFramingLength;
 
-#ifdef I2C_MUX
-#include "TCA9548A.h"
-const unsigned int gMuxAddress = 0x70;
-TCA9548A gTca;
-#endif // I2C_MUX
+// The displays and muxes on each bus are written to by a worker thread of
+// their own, so that the buses are sent to at the same time. This is filled
+// at startup.
+struct Bus {
+	unsigned int number;
+	std::vector<unsigned int> displays; // indices in gDisplays
+	int mux; // the segment the bus is routed to: -1 for the bus itself,
+	int channel; // or mux and channel. mux is -2 before the first routing
+	std::unique_ptr<BusWorker> worker;
+	float usPerByte; // measured while sending
+};
+std::vector<Bus> gBuses;
+// the bytes of a page of image data are preceded by a few more for the
+// address and the commands to set the position
+const float kPageOverheadBytes = 8;
+const float kDefaultUsPerByte = 22.5; // 400kHz, 9 bits per byte
+const uint64_t gFlushSliceUs = 5000; // how long the buses are sent to before new messages are taken in
+unsigned int gMissedDeadlines = 0;
+uint64_t gMissesReportedMs = 0;
 
 /// Determines how to select which display a message is targeted to:
 typedef enum {
 	kTargetSingle, ///< Single target (one display).
-	kTargetEach, ///< The first argument to each message is an index corresponding to the target display
-	kTargetStateful, ///< Send a message to /target <float> to select which is the active display that all subsequent messages will be sent to
+	kTargetEach, ///< The first argument to each message is an index corresponding to the target display, or a string with a list of them
+	kTargetStateful, ///< Send a message to /target <float> [<float>...] to select which are the active displays that all subsequent messages will be sent to
 } TargetMode;
+const unsigned int kMaxTargets = 32; // sets of targets are bitmasks
 
-TargetMode gTargetMode = kTargetSingle; // can be changed with /targetMode
-OscReceiver oscReceiver;
+OscBatchReceiver oscReceiver;
+// The target mode and the selected display are kept for each sender (UDP
+// address and port, or stream connection), so that senders do not change
+// each other's targets.
+struct Session {
+	OscBatchReceiver::Peer peer;
+	TargetMode mode; // can be changed with /targetMode
+	uint32_t targets; // bitmask of displays, can be changed with /target
+};
+std::vector<Session> gSessions;
+const size_t gMaxSessions = 32;
+OscMessageWriter oscWriter; // for replies
+// peers which asked for a /frame-done after each buffer is sent to a display
+std::vector<OscBatchReceiver::Peer> gFrameDoneSubscribers;
+size_t gBatchRemaining = 0; // messages of the current batch still to be processed
 int gStop = 0;
 
 // Handle Ctrl-C by requesting that the audio rendering stop
@@ -139,6 +295,59 @@ void interrupt_handler(int var)
 	gStop = true;
 }
 
+// find the session of peer, or start one
+static Session& getSession(const OscBatchReceiver::Peer& peer)
+{
+	for(auto& session : gSessions)
+	{
+		if(session.peer == peer)
+			return session;
+	}
+	if(gSessions.size() >= gMaxSessions)
+	{
+		// make room by forgetting closed connections, or else the oldest session
+		gSessions.erase(std::remove_if(gSessions.begin(), gSessions.end(), [](const Session& session) {
+			return !oscReceiver.isConnected(session.peer);
+		}), gSessions.end());
+		if(gSessions.size() >= gMaxSessions)
+			gSessions.erase(gSessions.begin());
+	}
+	gSessions.push_back({peer, kTargetSingle, 1});
+	return gSessions.back();
+}
+
+// pops a display index, or a list of them as a string such as "0 2 3", as a
+// bitmask of displays. Returns 0 if there is none or any is out of range
+static uint32_t popTargets(OscMessageView::ArgReader& args)
+{
+	if(args.isStr())
+	{
+		OscStringView list;
+		args.popStr(list);
+		uint32_t targets = 0;
+		const char* p = list.c_str();
+		while(*p)
+		{
+			char* end;
+			long n = strtol(p, &end, 10);
+			if(end == p)
+			{
+				++p; // separator
+				continue;
+			}
+			if(n < 0 || n >= long(gDisplays.size()))
+				return 0;
+			targets |= 1u << n;
+			p = end;
+		}
+		return targets;
+	}
+	int target;
+	if(args.popNumber(target) && target >= 0 && target < int(gDisplays.size()))
+		return 1u << target;
+	return 0;
+}
+
 static void switchTarget(unsigned int target)
 {
 	if(target >= gDisplays.size())
@@ -146,21 +355,602 @@ static void switchTarget(unsigned int target)
 		fprintf(stderr, "Invalid target %d\n", target);
 		return;
 	}
-#ifdef I2C_MUX
-	int mux = gDisplays[target].mux;
-	static int oldMux = -1;
-	if(oldMux != mux)
-		gTca.select(mux);
-#endif // I2C_MUX
 	gActiveTarget = target;
 }
 
-int parseMessage(oscpkt::Message msg, const char* address, void*)
+static uint64_t getTimeMs()
+{
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t getTimeUs()
+{
+	using namespace std::chrono;
+	return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static Bus& getBus(unsigned int number)
+{
+	for(auto& bus : gBuses)
+	{
+		if(bus.number == number)
+			return bus;
+	}
+	gBuses.push_back({number, {}, -2, -1, std::unique_ptr<BusWorker>(new BusWorker), kDefaultUsPerByte});
+	return gBuses.back();
+}
+
+// make the segment behind channel of mux (or the bus itself if mux is -1)
+// reachable: enable the channels of the muxes on the way to it and disable
+// those of the other muxes on each segment on the way, apart from keep
+static int openSegment(unsigned int bus, int mux, int channel, int keep)
+{
+	int ret = 0;
+	if(mux >= 0)
+	{
+		ret |= openSegment(bus, gMuxes[mux].parent, gMuxes[mux].channel, mux);
+		ret |= gMuxes[mux].tca.select(channel);
+	}
+	for(unsigned int n = 0; n < gMuxes.size(); ++n)
+	{
+		Mux& other = gMuxes[n];
+		bool onSegment = mux < 0 ? other.parent < 0 && other.bus == bus : other.parent == mux && other.channel == channel;
+		if(onSegment && int(n) != keep)
+			ret |= other.tca.select(-1);
+	}
+	return ret;
+}
+
+// route bus to the segment behind channel of mux, -1 for the bus itself.
+// The muxes are only written to when their channel changes
+static int route(Bus& bus, int mux, int channel)
+{
+	if(mux < 0)
+		channel = -1;
+	if(mux == bus.mux && channel == bus.channel)
+		return 0;
+	int ret = openSegment(bus.number, mux, channel, -1);
+	bus.mux = ret ? -2 : mux;
+	bus.channel = channel;
+	return ret;
+}
+
+// route the bus of display to it before writing to it. Messages only draw
+// to the buffer, so this is done when the display is sent to
+static void selectMux(const Display& display)
+{
+	if(!display.d.isCanvas())
+		route(gBuses[display.bus], display.mux, display.channel);
+}
+
+// false while the bus of display is still being initialised by its worker,
+// which is then the only one to write to it
+static bool isReady(const Display& display)
+{
+	return display.d.isCanvas() || !gBuses[display.bus].worker->isBusy();
+}
+
+// a display being initialised and the lock on its bus, which it holds
+// apart from during the delays of its init sequence
+struct DisplayInit {
+	std::mutex& busMutex;
+	const Display& display;
+};
+
+// the delay callback of displays while they are initialised: the bus is
+// sent to the other displays on it during the delays (e.g. after a reset)
+static uint8_t initDelay(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr)
+{
+	if(U8X8_MSG_DELAY_MILLI != msg)
+		return u8x8_linux_i2c_delay(u8x8, msg, arg_int, arg_ptr);
+	DisplayInit& init = *(DisplayInit*)u8x8_GetUserPtr(u8x8);
+	init.busMutex.unlock();
+	uint8_t ret = u8x8_linux_i2c_delay(u8x8, msg, arg_int, arg_ptr);
+	init.busMutex.lock();
+	// the bus may have been routed to another segment meanwhile
+	selectMux(init.display);
+	return ret;
+}
+
+static void initDisplay(Display& display, std::mutex& busMutex)
 {
+	DisplayInit init = {busMutex, display};
+	U8G2& u8g2 = display.d;
+	u8x8_t* u8x8 = u8g2.getU8x8();
+	u8x8_msg_cb delay = u8x8->gpio_and_delay_cb;
+	std::lock_guard<std::mutex> lock(busMutex);
+	u8g2.setUserPtr(&init);
+	u8x8->gpio_and_delay_cb = initDelay;
+	selectMux(display);
+	u8g2.initDisplay();
+	u8g2.setPowerSave(0);
+	u8g2.setContrast(display.effects.sentContrast);
+	u8x8->gpio_and_delay_cb = delay;
+	u8g2.setUserPtr(nullptr);
+}
+
+// initialise the displays of bus, each in a thread of its own so that
+// their init sequences overlap. Runs on the worker of bus
+static void initBus(Bus& bus)
+{
+	std::mutex busMutex;
+	std::vector<std::thread> threads;
+	for(unsigned int n : bus.displays)
+		threads.emplace_back([n, &busMutex]{ initDisplay(gDisplays[n], busMutex); });
+	for(auto& thread : threads)
+		thread.join();
+}
+
+// the estimated time it takes to send the rest of the frame of display
+static float getRemainingUs(Display& display, const Bus& bus)
+{
+	const Flush& flush = display.flush;
+	float bytes = 0;
+	for(unsigned int n = 0; n < flush.remaining; ++n)
+	{
+		uint16_t pageBytes = display.d.getPageBytes((flush.nextPage + n) % flush.pages);
+		if(pageBytes)
+			bytes += pageBytes + kPageOverheadBytes;
+	}
+	return bytes * bus.usPerByte;
+}
+
+// the estimated time it takes to send the next page of display which has changed
+static float getNextPageUs(Display& display, const Bus& bus)
+{
+	const Flush& flush = display.flush;
+	for(unsigned int n = 0; n < flush.remaining; ++n)
+	{
+		uint16_t pageBytes = display.d.getPageBytes((flush.nextPage + n) % flush.pages);
+		if(pageBytes)
+			return (pageBytes + kPageOverheadBytes) * bus.usPerByte;
+	}
+	return 0;
+}
+
+// the display of bus to send a page of next, -1 if there is none. This is
+// the one with the earliest deadline, unless sending a page of it could
+// make a display with a higher priority miss its deadline, in which case
+// the same is done among the displays with that priority or higher. At
+// the same deadline, the displays on the segment which the bus is routed to
+// go first, then one segment after the other, so that the muxes are
+// switched as few times as possible
+static int getNextFlush(Bus& bus, uint64_t now)
+{
+	static thread_local std::vector<unsigned int> active;
+	active.clear();
+	for(unsigned int n : bus.displays)
+	{
+		if(gDisplays[n].flush.pages && !gDisplays[n].flush.done)
+			active.push_back(n);
+	}
+	if(active.empty())
+		return -1;
+	auto segmentOrder = [&bus](unsigned int n) {
+		const Display& display = gDisplays[n];
+		if(display.mux == bus.mux && (display.mux < 0 || display.channel == bus.channel))
+			return -2;
+		return display.mux < 0 ? -1 : display.mux * 8 + display.channel;
+	};
+	std::sort(active.begin(), active.end(), [&segmentOrder](unsigned int a, unsigned int b) {
+		const Flush& fa = gDisplays[a].flush;
+		const Flush& fb = gDisplays[b].flush;
+		if(fa.deadline != fb.deadline)
+			return fa.deadline < fb.deadline;
+		return segmentOrder(a) < segmentOrder(b);
+	});
+	static thread_local std::vector<int> priorities;
+	priorities.clear();
+	for(unsigned int n : active)
+		priorities.push_back(gDisplays[n].priority);
+	std::sort(priorities.begin(), priorities.end(), std::greater<int>());
+	priorities.erase(std::unique(priorities.begin(), priorities.end()), priorities.end());
+	int minPriority = INT_MIN;
+	for(int priority : priorities)
+	{
+		// the longest a display with this priority or higher would have to
+		// wait for a page of one with a lower priority
+		float waitUs = 0;
+		for(unsigned int n : active)
+		{
+			if(gDisplays[n].priority < priority)
+				waitUs = std::max(waitUs, getNextPageUs(gDisplays[n], bus));
+		}
+		if(!waitUs)
+			break;
+		// can all of them still be sent before their deadlines after that?
+		// Frames which are already late don't count. A slice is kept as a
+		// margin for the time spent outside of the slices and for
+		// estimates which are too short
+		float t = waitUs + gFlushSliceUs;
+		bool feasible = true;
+		for(unsigned int n : active)
+		{
+			Display& display = gDisplays[n];
+			if(display.priority < priority || display.flush.deadline < now)
+				continue;
+			t += getRemainingUs(display, bus);
+			feasible &= t <= display.flush.deadline - now;
+		}
+		if(!feasible)
+		{
+			minPriority = priority;
+			break;
+		}
+	}
+	for(unsigned int n : active)
+	{
+		if(gDisplays[n].priority >= minPriority)
+			return n;
+	}
+	return -1;
+}
+
+// send pages of the displays of bus for up to gFlushSliceUs. Runs on the
+// worker of bus
+static void flushBus(Bus& bus)
+{
+	uint64_t start = getTimeUs();
+	uint64_t now = start;
+	int n;
+	while(now - start < gFlushSliceUs && (n = getNextFlush(bus, now)) >= 0)
+	{
+		Display& display = gDisplays[n];
+		Flush& flush = display.flush;
+		uint8_t page = flush.nextPage;
+		flush.nextPage = (page + 1) % flush.pages;
+		--flush.remaining;
+		uint16_t bytes = display.d.getPageBytes(page);
+		if(bytes)
+		{
+			selectMux(display);
+			display.d.sendPage(page);
+			uint64_t end = getTimeUs();
+			uint64_t us = end - now;
+			flush.busUs += us;
+			// a slow average, as the transfers are also delayed by other threads
+			bus.usPerByte += (us / (bytes + kPageOverheadBytes) - bus.usPerByte) * 0.05f;
+			now = end;
+		}
+		if(!flush.remaining)
+			flush.done = true;
+	}
+}
+
+// reply to /frame-done subscribers for the frame of display n, which has
+// been sent or has been dropped for new content, and count it as missed if
+// it has been sent past its deadline. A dropped frame is not counted: its
+// deadline is passed on to the frame which replaces it
+static void endFrame(unsigned int n, uint64_t now, bool dropped)
+{
+	Display& display = gDisplays[n];
+	Flush& flush = display.flush;
+	++display.frameSeq;
+	uint64_t lateUs = now > flush.deadline && flush.pages ? now - flush.deadline : 0;
+	if(lateUs && !dropped)
+	{
+		++display.missed;
+		++gMissedDeadlines;
+	}
+	if(gFrameDoneSubscribers.size())
+	{
+		oscWriter.init("/frame-done").pushInt32(n).pushInt32(display.frameSeq).pushInt32(flush.renderUs).pushInt32(flush.busUs).pushInt32(lateUs).pushInt32(dropped);
+		const std::string& reply = oscWriter.data();
+		for(size_t k = 0; k < gFrameDoneSubscribers.size(); )
+		{
+			// subscribers over closed connections are forgotten
+			if(oscReceiver.send(gFrameDoneSubscribers[k], reply.data(), reply.size()) || oscReceiver.isConnected(gFrameDoneSubscribers[k]))
+				++k;
+			else
+				gFrameDoneSubscribers.erase(gFrameDoneSubscribers.begin() + k);
+		}
+	}
+	flush = Flush();
+}
+
+// take the content of the displays which have been drawn to, to be sent
+static void startFlushes()
+{
+	uint64_t now = getTimeUs();
+	for(unsigned int n = 0; n < gShouldSend.size(); ++n)
+	{
+		Display& display = gDisplays[n];
+		// displays which are still being initialised are sent once they are ready
+		if(!gShouldSend[n] || !isReady(display))
+			continue;
+		gShouldSend[n] = false;
+		Flush& flush = display.flush;
+		// a frame which has not been reported yet ends here. If it is still
+		// being sent, it is dropped: the new one keeps its deadline, so that
+		// frames which are drawn over faster than they can be sent still
+		// miss it, and continues from the page it was at, so that all the
+		// pages get sent in turn
+		uint8_t nextPage = flush.nextPage;
+		uint64_t deadline = flush.deadline;
+		bool dropped = flush.pages && !flush.done;
+		if(flush.pages || flush.done)
+			endFrame(n, now, dropped);
+		float fps = display.fps > 0 ? display.fps : gDefaultFps;
+		flush.deadline = dropped ? deadline : now + uint64_t(1000000 / fps);
+		flush.renderUs = display.renderUs;
+		display.renderUs = 0;
+		flush.pages = display.d.isCanvas() ? 0 : display.d.prepareSendPages();
+		flush.remaining = flush.pages;
+		flush.nextPage = nextPage < flush.pages ? nextPage : 0;
+		flush.done = !flush.pages;
+	}
+}
+
+static bool isFlushing()
+{
+	for(auto& display : gDisplays)
+	{
+		if(display.flush.pages && !display.flush.done)
+			return true;
+	}
+	return false;
+}
+
+// send the displays which have been drawn to, all buses at the same time:
+// the last bus with something to send is done by this thread, which would
+// otherwise just wait, and the others by their workers
+static void flushBuses()
+{
+	static std::vector<Bus*> started;
+	started.clear();
+	Bus* last = nullptr;
+	for(auto& bus : gBuses)
+	{
+		bool active = false;
+		for(unsigned int n : bus.displays)
+			active |= gDisplays[n].flush.pages && !gDisplays[n].flush.done;
+		if(!active)
+			continue;
+		if(last)
+		{
+			last->worker->run([last]{ flushBus(*last); });
+			started.push_back(last);
+		}
+		last = &bus;
+	}
+	if(last)
+		flushBus(*last);
+	for(Bus* bus : started)
+		bus->worker->wait();
+}
+
+// reply to /frame-done subscribers for the frames which have been sent, and
+// report the missed deadlines every second
+static void finishFlushes()
+{
+	uint64_t now = getTimeUs();
+	for(unsigned int n = 0; n < gDisplays.size(); ++n)
+	{
+		if(gDisplays[n].flush.done)
+			endFrame(n, now, false);
+	}
+	if(now / 1000 - gMissesReportedMs < 1000)
+		return;
+	gMissesReportedMs = now / 1000;
+	for(unsigned int n = 0; n < gDisplays.size(); ++n)
+	{
+		if(gDisplays[n].missed)
+			fprintf(stderr, "Display %u missed its deadline %u times in the last second\n", n, gDisplays[n].missed);
+		gDisplays[n].missed = 0;
+	}
+}
+
+const uint64_t kEffectForever = UINT64_MAX;
+const unsigned int gEffectsIntervalUs = 10000; // how often running effects are updated
+
+// send the command writes for the effects of display that are due at time now.
+// Returns true while any of them still needs updating.
+static bool processEffects(Display& display, uint64_t now)
+{
+	Effects& e = display.effects;
+	U8G2& u8g2 = display.d;
+	bool active = false;
+	if(e.fadeEnd)
+	{
+		if(now >= e.fadeEnd)
+		{
+			e.contrast = e.fadeTo;
+			e.fadeEnd = 0;
+		} else {
+			e.contrast = e.fadeFrom + (e.fadeTo - e.fadeFrom) * float(now - e.fadeStart) / float(e.fadeEnd - e.fadeStart);
+			active = true;
+		}
+	}
+	int contrast = std::round(e.contrast * 255);
+	if(contrast != e.sentContrast)
+	{
+		selectMux(display);
+		u8g2.setContrast(contrast);
+		e.sentContrast = contrast;
+	}
+	for(uint64_t* end : {&e.invertEnd, &e.flashEnd})
+	{
+		if(*end && now >= *end)
+			*end = 0;
+		else if(*end && kEffectForever != *end)
+			active = true;
+	}
+	uint8_t pixelMode = (e.invertEnd ? U8X8_PIXEL_MODE_INVERSE : 0) | (e.flashEnd ? U8X8_PIXEL_MODE_ALL_ON : 0);
+	if(pixelMode != e.sentPixelMode)
+	{
+		selectMux(display);
+		u8g2.setPixelMode(pixelMode);
+		e.sentPixelMode = pixelMode;
+	}
+	if(e.blinkInterval)
+	{
+		if(now >= e.nextBlink)
+		{
+			e.blinkOff = !e.blinkOff;
+			selectMux(display);
+			u8g2.setPowerSave(e.blinkOff);
+			e.nextBlink += e.blinkInterval;
+			if(e.nextBlink <= now) // we fell behind: don't try to catch up
+				e.nextBlink = now + e.blinkInterval;
+		}
+		active = true;
+	} else if(e.blinkOff)
+	{
+		e.blinkOff = false;
+		selectMux(display);
+		u8g2.setPowerSave(0);
+	}
+	return active;
+}
+
+static void setupMenu(Menu& menu)
+{
+	menu.values.assign((sizeof(kMenuValueKinds) - 1) * kMenuValuesPerKind, 0);
+	menu.numbers.resize(kMenuValuesPerKind);
+	menu.bars.resize(kMenuValuesPerKind);
+	menu.muif = {
+		MUIF_U8G2_FONT_STYLE(0, u8g2_font_5x8_tf),
+		MUIF_U8G2_FONT_STYLE(1, u8g2_font_ncenB08_tr),
+		MUIF_U8G2_FONT_STYLE(2, u8g2_font_4x6_tf),
+		MUIF_U8G2_LABEL(),
+		MUIF_GOTO(mui_u8g2_btn_goto_wm_fi),
+	};
+	for(unsigned int n = 0; n < kMenuValuesPerKind; ++n)
+	{
+		uint8_t id1 = '0' + n;
+		uint8_t* values = menu.values.data() + n;
+		menu.numbers[n] = {values, 0, 255};
+		menu.bars[n] = {values + kMenuValuesPerKind, 0, 100, 1, MUI_MMS_SHOW_VALUE};
+		menu.muif.push_back({'N', id1, MUIF_CFLAG_IS_CURSOR_SELECTABLE, 0, &menu.numbers[n], mui_u8g2_u8_min_max_wm_mse_pi});
+		menu.muif.push_back({'B', id1, MUIF_CFLAG_IS_CURSOR_SELECTABLE, 0, &menu.bars[n], mui_u8g2_u8_bar_wm_mse_pi});
+		menu.muif.push_back({'C', id1, MUIF_CFLAG_IS_CURSOR_SELECTABLE, 0, values + 2 * kMenuValuesPerKind, mui_u8g2_u8_chkbox_wm_pi});
+		menu.muif.push_back({'O', id1, MUIF_CFLAG_IS_CURSOR_SELECTABLE, 0, values + 3 * kMenuValuesPerKind, mui_u8g2_u8_opt_line_wa_mse_pi});
+	}
+}
+
+// the variable of field id, nullptr if there is none
+static uint8_t* getMenuValue(Menu& menu, const OscStringView& id)
+{
+	const char* kind = id.size() == 2 && id[0] ? strchr(kMenuValueKinds, id[0]) : nullptr;
+	if(!kind || id[1] < '0' || id[1] >= int('0' + kMenuValuesPerKind))
+		return nullptr;
+	return &menu.values[(kind - kMenuValueKinds) * kMenuValuesPerKind + id[1] - '0'];
+}
+
+// span tables of the ellipses drawn by /lfos, keyed by their radii.
+// While the LFOs are running the same few radii come up over and over again.
+struct EllipseSpans {
+	u8g2_uint_t rx;
+	u8g2_uint_t ry;
+	std::vector<u8g2_uint_t> spans;
+};
+std::vector<EllipseSpans> gEllipseSpans;
+const unsigned int gMaxEllipseSpans = 64;
+
+static void drawCachedEllipse(U8G2& u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry)
+{
+	if(ry > U8G2_MAX_SPAN_RADIUS)
+	{
+		u8g2.drawEllipse(x0, y0, rx, ry);
+		return;
+	}
+	auto it = std::find_if(gEllipseSpans.begin(), gEllipseSpans.end(), [rx, ry](const EllipseSpans& e) {
+		return e.rx == rx && e.ry == ry;
+	});
+	if(gEllipseSpans.end() == it)
+	{
+		if(gEllipseSpans.size() >= gMaxEllipseSpans)
+			gEllipseSpans.clear();
+		gEllipseSpans.push_back({rx, ry, std::vector<u8g2_uint_t>(ry + 1)});
+		it = gEllipseSpans.end() - 1;
+		u8g2_CalculateEllipseSpans(it->spans.data(), rx, ry);
+	}
+	u8g2.drawSpans(x0, y0, it->spans.data(), ry);
+}
+
+static int parseGroupMessage(const OscMessageView& msg, const OscBatchReceiver::Packet& packet, uint32_t targets);
+
+// the bitmask of the panels of a video wall
+static uint32_t getPanels(unsigned int wall)
+{
+	uint32_t panels = 0;
+	for(auto& panel : gPanels)
+	{
+		if(panel.wall == wall)
+			panels |= 1u << panel.display;
+	}
+	return panels;
+}
+
+// copy the canvases which have been drawn to into their panels, and mark the
+// panels which have changed to be sent
+static void splitWalls()
+{
+	for(auto& panel : gPanels)
+	{
+		if(!gShouldSend[panel.wall])
+			continue;
+		Display& display = gDisplays[panel.display];
+		if(display.d.copyBufferTiles(gDisplays[panel.wall].d, panel.x / 8, panel.y / 8))
+		{
+			display.log.isShown = false;
+			display.menu.isShown = false;
+			gShouldSend[panel.display] = true;
+		}
+	}
+}
+
+// messages which clear the display and draw only from their own arguments.
+// If a batch contains more of them with the same address for the same
+// display, only the last one is drawn.
+static bool isSnapshotMessage(const OscMessageView& msg)
+{
+	for(auto address : {"/osc-test", "/number", "/display-text", "/display-strings-and-numbers", "/parameters", "/lfos", "/waveform", "/meters"})
+	{
+		if(msg.match(address))
+			return true;
+	}
+	return false;
+}
+
+// true if the arguments of a snapshot message have the types parseMessage()
+// expects, so that it is drawn. A malformed one leaves the display as it is
+// and does not supersede earlier ones
+static bool hasSnapshotArgs(const OscMessageView& msg, OscMessageView::ArgReader args)
+{
+	float value;
+	OscStringView str;
+	if(msg.match("/osc-test"))
+		return args.isOkNoMoreArgs();
+	if(msg.match("/number"))
+		return args.popNumber(value).isOkNoMoreArgs();
+	if(msg.match("/display-text"))
+		return args.popStr(str).popStr(str).popStr(str).isOkNoMoreArgs();
+	if(msg.match("/parameters") || msg.match("/lfos"))
+		return args.popFloat(value).popFloat(value).popFloat(value).isOkNoMoreArgs();
+	if(!args.nbArgRemaining() && (msg.match("/waveform") || msg.match("/meters")))
+		return false;
+	while(args.nbArgRemaining() && args.isOk())
+	{
+		if(msg.match("/waveform") && !args.isFloat() && !args.isInt32())
+			return false;
+		if(msg.match("/display-strings-and-numbers") && args.isStr())
+			args.popStr(str);
+		else
+			args.popNumber(value);
+	}
+	return args.isOkNoMoreArgs();
+}
+
+// targets, if not 0, overrides the displays selected by the sender
+int parseMessage(const OscMessageView& msg, const OscBatchReceiver::Packet& packet, uint32_t targets = 0)
+{
+	uint64_t start = getTimeUs();
 	float param1Value;
 	float param2Value;
 	float param3Value;
-	oscpkt::Message::ArgReader args = msg.arg();
+	OscMessageView::ArgReader args = msg.arg();
 	enum {
 		kOk = 0,
 		kUnmatchedPattern,
@@ -168,22 +958,29 @@ int parseMessage(oscpkt::Message msg, const char* address, void*)
 		kInvalidMode,
 		kOutOfRange,
 	} error = kOk;
-	printf("Message from %s\n", address);
+	printf("Message from %s\n", packet.from);
 	bool stateMessage = false;
+	Session& session = getSession(packet.peer);
 	// check state (non-display) messages first
 	if (msg.match("/target")) {
 		stateMessage = true;
-		if(kTargetStateful != gTargetMode) {
+		if(kTargetStateful != session.mode) {
 			fprintf(stderr, "Target mode is not stateful, so /target messages are ignored\n");
 			error = kInvalidMode;
 		} else {
-			int target;
-			if(args.popNumber(target).isOkNoMoreArgs()) {
-				printf("Selecting /target %d\n", target);
-				switchTarget(target);
-			} else {
-				fprintf(stderr, "Argument to /target should be numeric (int or float)\n");
+			// one or more displays: the message is drawn once and shown on all of them
+			uint32_t selected = 0;
+			uint32_t t;
+			while(args.nbArgRemaining() && (t = popTargets(args)))
+				selected |= t;
+			if(!args.isOk() || !selected) {
+				fprintf(stderr, "Arguments to /target should be numeric (int or float) or a string with a list of displays\n");
 				error = kWrongArguments;
+			} else if(args.nbArgRemaining())
+				error = kOutOfRange;
+			else {
+				printf("Selecting /target 0x%x\n", selected);
+				session.targets = selected;
 			}
 		}
 	} else if (msg.match("/targetMode")) {
@@ -194,33 +991,92 @@ int parseMessage(oscpkt::Message msg, const char* address, void*)
 			if(mode != kTargetSingle && mode != kTargetStateful && mode != kTargetEach)
 				error = kOutOfRange;
 			else {
-				gTargetMode = (TargetMode)mode;
+				session.mode = (TargetMode)mode;
 				printf("Target mode: %d\n", mode);
 			}
 		} else
 			error = kWrongArguments;
+	} else if (msg.match("/frame-done/subscribe")) {
+		// the sender gets /frame-done <display> <seq> <render us> <bus us>
+		// <late us> <dropped> each time a frame of a display is sent or dropped,
+		// until it sends 0
+		stateMessage = true;
+		int enable = 1;
+		if((args.nbArgRemaining() && !args.popNumber(enable)) || !args.isOkNoMoreArgs())
+			error = kWrongArguments;
+		else {
+			auto it = std::find(gFrameDoneSubscribers.begin(), gFrameDoneSubscribers.end(), packet.peer);
+			if(enable && gFrameDoneSubscribers.end() == it)
+				gFrameDoneSubscribers.push_back(packet.peer);
+			else if(!enable && gFrameDoneSubscribers.end() != it)
+				gFrameDoneSubscribers.erase(it);
+			printf("%s /frame-done for %s\n", enable ? "Enabled" : "Disabled", packet.from);
+		}
+	} else if (msg.match("/status")) {
+		// reply with what is waiting to be done: messages received but not
+		// processed yet, bytes received on stream connections but not parsed
+		// yet, displays which have been drawn to but not sent yet and the
+		// frames sent after their deadline since startup
+		stateMessage = true;
+		if(!args.isOkNoMoreArgs())
+			error = kWrongArguments;
+		else {
+			int pending = 0;
+			for(unsigned int n = 0; n < gDisplays.size(); ++n)
+				pending += (n < gShouldSend.size() && gShouldSend[n]) || (gDisplays[n].flush.pages && !gDisplays[n].flush.done);
+			oscWriter.init("/status").pushInt32(gBatchRemaining).pushInt32(oscReceiver.getQueuedBytes()).pushInt32(pending).pushInt32(gMissedDeadlines);
+			const std::string& reply = oscWriter.data();
+			oscReceiver.send(packet.peer, reply.data(), reply.size());
+		}
+	}
+	if(!stateMessage)
+	{
+		uint32_t selected = session.targets;
+		if(kTargetEach == session.mode)
+		{
+			// if we are in kTargetEach and the message is for a display, we need to peel off the
+			// first argument (which denotes the target displays) before processing the message
+			bool isList = args.isStr();
+			if(!(selected = popTargets(args)))
+			{
+				if(!args.isOk() && !isList)
+				{
+					fprintf(stderr, "Target mode is \"Each\", therefore the first argument should be an int or float specifying the target display, or a string with a list of them\n");
+					error = kWrongArguments;
+				} else
+					error = kOutOfRange;
+			}
+		}
+		if(targets)
+			selected = targets;
+		if(kOk == error && (selected & (selected - 1)))
+			return parseGroupMessage(msg, packet, selected);
+		if(selected && __builtin_ctz(selected) != int(gActiveTarget))
+			switchTarget(__builtin_ctz(selected));
 	}
 	if(gActiveTarget >= gDisplays.size())
 	{
 		fprintf(stderr, "Target %u out of range. Only %u displays are available\n", gActiveTarget, gDisplays.size());
 		return 1;
 	}
-	if(!stateMessage && kTargetEach == gTargetMode)
+	// effects don't touch the framebuffer, so it's not cleared or sent for them
+	bool effectMessage = msg.partialMatch("/effect/");
+	// a canvas has no controller: its effects are run on its panels
+	if(effectMessage && !stateMessage && kOk == error && gDisplays[gActiveTarget].d.isCanvas())
+		return parseGroupMessage(msg, packet, getPanels(gActiveTarget));
+	// the log and the forms are updated in place
+	bool logMessage = msg.match("/log");
+	bool menuMessage = msg.partialMatch("/mui/");
+	// a malformed snapshot message fails below without drawing: the buffer
+	// keeps what was drawn to it before, e.g. earlier in the same batch
+	bool malformedSnapshot = isSnapshotMessage(msg) && !hasSnapshotArgs(msg, args);
+	U8G2& u8g2 = gDisplays[gActiveTarget].d;
+	if(!stateMessage && !effectMessage && !logMessage && !menuMessage && !malformedSnapshot)
 	{
-		// if we are in kTargetEach and the message is for a display, we need to peel off the
-		// first argument (which denotes the target display) before processing the message
-		int target;
-		if(args.popNumber(target))
-		{
-			switchTarget(target);
-		} else {
-			fprintf(stderr, "Target mode is \"Each\", therefore the first argument should be an int or float specifying the target display\n");
-			error = kWrongArguments;
-		}
+		u8g2.clearBuffer();
+		gDisplays[gActiveTarget].log.isShown = false;
+		gDisplays[gActiveTarget].menu.isShown = false;
 	}
-	mtx.lock();
-	U8G2& u8g2 = gDisplays[gActiveTarget].d;
-	u8g2.clearBuffer();
 	int displayWidth = u8g2.getDisplayWidth();
 	int displayHeight = u8g2.getDisplayHeight();
 
@@ -229,6 +1085,203 @@ int parseMessage(oscpkt::Message msg, const char* address, void*)
 	gShouldSend.resize(gDisplays.size());
 	if(error || stateMessage) {
 		// nothing to do here, just avoid matching any of the others
+	} else if (effectMessage)
+	{
+		Effects& effects = gDisplays[gActiveTarget].effects;
+		uint64_t now = getTimeMs();
+		float value;
+		float ms = 0;
+		if(!args.popNumber(value) || (args.nbArgRemaining() && !args.popNumber(ms)) || !args.isOkNoMoreArgs())
+			error = kWrongArguments;
+		else if(msg.match("/effect/fade"))
+		{
+			// fade the contrast from its current value to value (0 to 1) in ms milliseconds
+			if(value < 0 || value > 1)
+				error = kOutOfRange;
+			else if(ms > 0) {
+				effects.fadeFrom = effects.contrast;
+				effects.fadeTo = value;
+				effects.fadeStart = now;
+				effects.fadeEnd = now + uint64_t(ms);
+			} else {
+				effects.contrast = value;
+				effects.fadeEnd = 0;
+			}
+		} else if(msg.match("/effect/invert") || msg.match("/effect/flash"))
+		{
+			// invert the display or turn all of its pixels on for value milliseconds.
+			// 0 ends the effect, a negative value keeps it on until the next 0
+			uint64_t& end = msg.match("/effect/invert") ? effects.invertEnd : effects.flashEnd;
+			if(value < 0)
+				end = kEffectForever;
+			else if(value > 0)
+				end = now + uint64_t(value);
+			else
+				end = 0;
+		} else if(msg.match("/effect/blink"))
+		{
+			// turn the display off and on value times per second, 0 to stop
+			if(value < 0)
+				error = kOutOfRange;
+			else if(value > 0) {
+				uint64_t interval = std::max(500 / value, 1.f);
+				if(!effects.blinkInterval)
+					effects.nextBlink = now;
+				effects.blinkInterval = interval;
+			} else
+				effects.blinkInterval = 0;
+		} else
+			error = kUnmatchedPattern;
+		if(kOk == error)
+		{
+			printf("received %s %f\n", msg.addressPattern().c_str(), value);
+			// the effects of displays which are still being initialised are
+			// sent by the main loop once they are ready
+			Display& display = gDisplays[gActiveTarget];
+			if(isReady(display))
+				processEffects(display, now);
+		}
+	} else if (logMessage)
+	{
+		// append a line made of strings and numbers to the log of the display
+		std::stringstream out;
+		while(args.nbArgRemaining() && args.isOk() && kOk == error)
+		{
+			if(args.isStr())
+			{
+				OscStringView str;
+				args.popStr(str);
+				out << str << " ";
+			} else if(args.isInt32())
+			{
+				int32_t num;
+				args.popInt32(num);
+				out << num << " ";
+			} else if(args.isNumber())
+			{
+				double num;
+				args.popNumber(num);
+				out << std::fixed << std::setprecision(2) << num << " ";
+			} else
+				error = kWrongArguments;
+		}
+		if(!args.isOkNoMoreArgs())
+			error = kWrongArguments;
+		if(kOk == error)
+		{
+			Log& log = gDisplays[gActiveTarget].log;
+			std::string line = out.str();
+			if(line.size())
+				line.back() = '\n';
+			else
+				line = "\n";
+			printf("received /log %s", line.c_str());
+			u8g2.setFont(u8g2_font_5x8_tf);
+			u8g2.setFontRefHeightText();
+			u8g2.setFontPosBaseline();
+			int ascent = u8g2.getAscent();
+			if(log.screen.empty())
+			{
+				unsigned int width = displayWidth / u8g2.getMaxCharWidth();
+				unsigned int height = displayHeight / (ascent - u8g2.getDescent());
+				log.screen.resize(width * height);
+				log.log.begin(width, height, log.screen.data());
+			}
+			log.log.writeString(line.c_str());
+			if(log.isShown)
+			{
+				// only the new lines are drawn, the rest of the buffer scrolls
+				u8g2.drawLogChanges(0, ascent, log.log);
+			} else {
+				// another message has replaced the log
+				u8g2.clearBuffer();
+				u8g2.drawLog(0, ascent, log.log);
+				log.isShown = true;
+			}
+			u8g2.setFontPosTop(); // as set in main()
+		}
+	} else if (menuMessage)
+	{
+		Menu& menu = gDisplays[gActiveTarget].menu;
+		uint8_t id0 = 0; // id of the fields whose value was set
+		uint8_t id1 = 0;
+		if(msg.match("/mui/form"))
+		{
+			// load a form definition (blob), then go to its first or the given form
+			OscMessageView::Blob fds;
+			int form = -1;
+			int cursor = 0;
+			if(!args.popBlob(fds) || (args.nbArgRemaining() && !args.popNumber(form)) || (args.nbArgRemaining() && !args.popNumber(cursor)) || !args.isOkNoMoreArgs() || fds.size < 2)
+				error = kWrongArguments;
+			else {
+				if(menu.muif.empty())
+					setupMenu(menu);
+				menu.fds.assign(fds.data, fds.size);
+				menu.mui.begin(u8g2, menu.fds.c_str(), menu.muif.data(), menu.muif.size());
+				menu.isShown = false;
+				if(form < 0)
+					form = uint8_t(menu.fds[1]);
+				if(!menu.mui.gotoForm(form, cursor))
+					error = kOutOfRange;
+			}
+		} else if(menu.fds.empty())
+		{
+			fprintf(stderr, "No form loaded, send /mui/form first\n");
+			error = kInvalidMode;
+		} else if(msg.match("/mui/goto"))
+		{
+			int form;
+			int cursor = 0;
+			if(!args.popNumber(form) || (args.nbArgRemaining() && !args.popNumber(cursor)) || !args.isOkNoMoreArgs())
+				error = kWrongArguments;
+			else if(!menu.mui.gotoForm(form, cursor))
+				error = kOutOfRange;
+		} else if(msg.match("/mui/value"))
+		{
+			// set the variable of a field, e.g. /mui/value N3 42
+			OscStringView id;
+			int value;
+			uint8_t* ptr = nullptr;
+			if(!args.popStr(id).popNumber(value).isOkNoMoreArgs())
+				error = kWrongArguments;
+			else if(!(ptr = getMenuValue(menu, id)))
+				error = kOutOfRange;
+			else {
+				int max = 'B' == id[0] ? 100 : 'C' == id[0] ? 1 : 255;
+				*ptr = std::min(std::max(value, 0), max);
+				id0 = id[0];
+				id1 = id[1];
+			}
+		} else if(!args.isOkNoMoreArgs())
+			error = kWrongArguments;
+		else if(msg.match("/mui/next"))
+			menu.mui.nextField();
+		else if(msg.match("/mui/prev"))
+			menu.mui.prevField();
+		else if(msg.match("/mui/select"))
+			menu.mui.sendSelect();
+		else if(msg.match("/mui/increment"))
+			menu.mui.sendValueIncrement();
+		else if(msg.match("/mui/decrement"))
+			menu.mui.sendValueDecrement();
+		else
+			error = kUnmatchedPattern;
+		if(kOk == error)
+		{
+			printf("received %s, form %d, focus %d\n", msg.addressPattern().c_str(), menu.mui.getCurrentFormId(), menu.mui.getCurrentCursorFocusPosition());
+			u8g2.setFont(u8g2_font_5x8_tf);
+			u8g2.setFontPosBaseline();
+			if(menu.isShown)
+			{
+				// only the fields which have changed are drawn
+				menu.mui.drawChanges(&menu.areas, id0, id1);
+			} else {
+				u8g2.clearBuffer();
+				menu.mui.drawForm(&menu.areas);
+				menu.isShown = true;
+			}
+			u8g2.setFontPosTop(); // as set in main()
+		}
 	} else if (msg.match("/osc-test"))
 	{
 		if(!args.isOkNoMoreArgs()){
@@ -253,9 +1306,9 @@ int parseMessage(oscpkt::Message msg, const char* address, void*)
 			error = kWrongArguments;
 	} else if (msg.match("/display-text"))
 	{
-		std::string text1;
-		std::string text2;
-		std::string text3;
+		OscStringView text1;
+		OscStringView text2;
+		OscStringView text3;
 		if(!args.popStr(text1).popStr(text2).popStr(text3).isOkNoMoreArgs())
 			error = kWrongArguments;
 		else {
@@ -277,7 +1330,7 @@ int parseMessage(oscpkt::Message msg, const char* address, void*)
 		{
 			if(args.isStr())
 			{
-				std::string str;
+				OscStringView str;
 				args.popStr(str);
 				// Pd cannot send \n, but will send a literal \\n
 				if("\\n" == str || "\n" == str || "\n\r" == str)
@@ -343,41 +1396,119 @@ int parseMessage(oscpkt::Message msg, const char* address, void*)
 	{
 		if(!args.popFloat(param1Value).popFloat(param2Value).popFloat(param3Value).isOkNoMoreArgs())
 			error = kWrongArguments;
-		printf("received /lfos float %f float %f float %f\n", param1Value, param2Value, param3Value);
-		u8g2.drawEllipse(displayWidth * 0.2, displayHeight * 0.5, 10, displayHeight * 0.5 * param1Value);
-		u8g2.drawEllipse(displayWidth * 0.5, displayHeight * 0.5, 10, displayHeight * 0.5 * param2Value);
-		u8g2.drawEllipse(displayWidth * 0.8, displayHeight * 0.5, 10, displayHeight * 0.5 * param3Value);
-		u8g2.drawHLine(0, displayHeight * 0.5, displayWidth);
+		else {
+			printf("received /lfos float %f float %f float %f\n", param1Value, param2Value, param3Value);
+			drawCachedEllipse(u8g2, displayWidth * 0.2, displayHeight * 0.5, 10, displayHeight * 0.5 * param1Value);
+			drawCachedEllipse(u8g2, displayWidth * 0.5, displayHeight * 0.5, 10, displayHeight * 0.5 * param2Value);
+			drawCachedEllipse(u8g2, displayWidth * 0.8, displayHeight * 0.5, 10, displayHeight * 0.5 * param3Value);
+			u8g2.drawHLine(0, displayHeight * 0.5, displayWidth);
+		}
 	} else if (msg.match("/waveform"))
 	{
 		const unsigned int nValues = args.nbArgRemaining();
-		float values[nValues];
+		// the values are read in place from the packet and decimated on the
+		// fly: each column of the display gets the value at its position
+		u8g2_xy_t points[displayWidth];
+		unsigned int x = 0;
 		for(unsigned int n = 0; n < nValues; ++n)
 		{
+			float value;
 			if(args.isFloat())
 			{
-				args.popFloat(values[n]);
+				args.popFloat(value);
 			} else if(args.isInt32()) {
-				int i;
+				int32_t i;
 				args.popInt32(i);
-				values[n] = i;
+				value = i;
 			} else {
 				error = kWrongArguments;
+				break;
+			}
+			// we interpret each value as the vertical displacement and
+			// we want to draw a series of horizontal lines at the specified points
+			for(; x < unsigned(displayWidth) && (unsigned int)(x * float(nValues) / displayWidth) == n; ++x)
+			{
+				// values outside of the display are drawn as lines to its edge
+				float y = std::min(std::max(value * displayHeight, -1.f), float(displayHeight));
+				points[x] = {int16_t(x), int16_t(y)};
 			}
 		}
+		if(!nValues)
+			error = kWrongArguments;
 		if(!error)
 		{
 			printf("received /waveform with %d values\n", nValues);
 
-			// prepare a bitmap:
-			for(unsigned int x = 0; x < displayWidth; ++x)
+			// connecting the points avoids gaps in steep parts of the waveform
+			u8g2.drawPolyline(points, displayWidth);
+		}
+	} else if (msg.match("/meters"))
+	{
+		// one vertical bar per value (0 to 1). On grayscale displays brighter
+		// bars are also lighter
+		const unsigned int nValues = args.nbArgRemaining();
+		// not on the stack, as its size comes from the packet
+		static std::vector<float> values;
+		values.resize(nValues);
+		for(unsigned int n = 0; n < nValues && kOk == error; ++n)
+		{
+			if(!args.popNumber(values[n]))
+				error = kWrongArguments;
+		}
+		if(!nValues)
+			error = kWrongArguments;
+		if(!error)
+		{
+			printf("received /meters with %u values\n", nValues);
+			int barWidth = std::max(displayWidth / int(nValues), 1);
+			for(unsigned int n = 0; n < nValues; ++n)
 			{
-				// we interpret each value as the vertical displacement and
-				// we want to draw a series of horizontal lines at the specified points
-				unsigned int valIdx = x * float(nValues) / displayWidth;
-				unsigned int y = values[valIdx] * displayHeight;
-				u8g2.drawPixel(x, y);
+				float value = std::min(std::max(values[n], 0.f), 1.f);
+				int h = std::round(value * displayHeight);
+				if(!h)
+					continue;
+				u8g2.setGrayLevel(1 + std::round(value * 14));
+				u8g2.drawBox(n * barWidth, displayHeight - h, std::max(barWidth - 1, 1), h);
 			}
+			u8g2.setGrayLevel(U8G2_GRAY_MONO);
+		}
+	} else if (msg.match("/plot"))
+	{
+		// rolling strip chart: each value is appended to the right and
+		// the older ones move one pixel to the left
+		std::vector<float>& samples = gDisplays[gActiveTarget].plotSamples;
+		unsigned int nNew = 0;
+		while(args.nbArgRemaining() && kOk == error)
+		{
+			float value;
+			if(args.popNumber(value))
+			{
+				samples.push_back(value);
+				++nNew;
+			} else
+				error = kWrongArguments;
+		}
+		if(!nNew)
+			error = kWrongArguments;
+		if(samples.size() > size_t(displayWidth))
+			samples.erase(samples.begin(), samples.end() - displayWidth);
+		if(!error)
+		{
+			printf("received /plot with %u values\n", nNew);
+			u8g2_xy_t points[displayWidth];
+			unsigned int nPoints = samples.size();
+			for(unsigned int n = 0; n < nPoints; ++n)
+			{
+				float y = std::min(std::max(samples[n] * displayHeight, -1.f), float(displayHeight));
+				points[n] = {int16_t(displayWidth - nPoints + n), int16_t(y)};
+			}
+			u8g2.drawPolyline(points, nPoints);
+			// on displays mounted at 90 degrees (U8G2_R1/U8G2_R3 with rotate at
+			// flush), the display start line follows the movement and only the
+			// new columns are sent. On U8G2_R0 a single new sample is scrolled in
+			// by controllers with a one column content scroll (SSD1309); on the
+			// others most of the buffer is sent for each sample
+			u8g2.scrollFlushRotation(-int(nNew), 0);
 		}
 	} else if (msg.partialMatch("/points/"))
 	{
@@ -461,6 +1592,8 @@ int parseMessage(oscpkt::Message msg, const char* address, void*)
 			std::string out;
 			out.reserve(displayHeight * displayWidth + displayHeight);
 #endif // PRINT_POINTS
+			std::vector<u8g2_xy_t> points;
+			points.reserve(displayHeight * displayWidth);
 			for(unsigned int py = 0; py < displayHeight; ++py)
 			{
 				for(unsigned int px = 0; px < displayWidth; ++px)
@@ -471,7 +1604,7 @@ int parseMessage(oscpkt::Message msg, const char* address, void*)
 #endif // PRINT_POINTS
 					if(values[idx])
 					{
-						u8g2.drawPixel(px, py);
+						points.push_back({int16_t(px), int16_t(py)});
 						values[idx]--;
 					}
 				}
@@ -482,6 +1615,7 @@ int parseMessage(oscpkt::Message msg, const char* address, void*)
 #ifdef PRINT_POINTS
 			printf("%s", out.c_str());
 #endif // PRINT_POINTS
+			u8g2.drawPixels(points.data(), points.size());
 		}
 	} else
 		error = kUnmatchedPattern;
@@ -510,78 +1644,336 @@ int parseMessage(oscpkt::Message msg, const char* address, void*)
 		ret = 1;
 	} else
 	{
-		if(!stateMessage)
+		if(!stateMessage && !effectMessage)
 			gShouldSend[gActiveTarget] = true;
 	}
-	mtx.unlock();
+	if(!stateMessage)
+		gDisplays[gActiveTarget].renderUs += getTimeUs() - start;
+	return ret;
+}
+
+// the buffer of display a can be copied into display b and sent as it is
+static bool canMirror(unsigned int a, unsigned int b)
+{
+	u8g2_t* ua = gDisplays[a].d.getU8g2();
+	u8g2_t* ub = gDisplays[b].d.getU8g2();
+	if(ua->cb != ub->cb || ua->gray || ub->gray || !ua->flush_rotation != !ub->flush_rotation)
+		return false;
+	if(ua->flush_rotation && ua->flush_rotation->rotation != ub->flush_rotation->rotation)
+		return false;
+	return u8g2_GetBufferTileWidth(ua) == u8g2_GetBufferTileWidth(ub) && u8g2_GetBufferTileHeight(ua) == u8g2_GetBufferTileHeight(ub);
+}
+
+// A message for several displays is drawn once into the first one and its
+// buffer is copied into all the others which have the same buffer layout;
+// the remaining ones are drawn to separately. The copies show the content of
+// the first display, including its log, form and plot.
+// Effects are run on each display.
+static int parseGroupMessage(const OscMessageView& msg, const OscBatchReceiver::Packet& packet, uint32_t targets)
+{
+	int ret = 0;
+	bool effectMessage = msg.partialMatch("/effect/");
+	while(targets)
+	{
+		unsigned int first = __builtin_ctz(targets);
+		targets &= ~(1u << first);
+		uint32_t mirrors = 0;
+		for(unsigned int n = first + 1; n < gDisplays.size() && !effectMessage; ++n)
+		{
+			if((targets & (1u << n)) && canMirror(first, n))
+				mirrors |= 1u << n;
+		}
+		targets &= ~mirrors;
+		if(parseMessage(msg, packet, 1u << first))
+		{
+			ret = 1;
+			continue;
+		}
+		if(!gShouldSend[first])
+			continue;
+		U8G2& u8g2 = gDisplays[first].d;
+		size_t size = 8 * u8g2.getBufferTileWidth() * u8g2.getBufferTileHeight();
+		for(unsigned int n = first + 1; n < gDisplays.size(); ++n)
+		{
+			if(mirrors & (1u << n))
+			{
+				Display& display = gDisplays[n];
+				memcpy(display.d.getBufferPtr(), u8g2.getBufferPtr(), size);
+				display.log.isShown = false;
+				display.menu.isShown = false;
+				gShouldSend[n] = true;
+			}
+		}
+	}
 	return ret;
 }
 
+struct BatchMessage {
+	OscMessageView msg; // points into the receive buffer
+	const OscBatchReceiver::Packet* packet;
+	uint32_t targets; // 0 for state messages
+	bool canSupersede; // a snapshot message which is drawn
+	bool superseded;
+};
+std::vector<BatchMessage> gBatch;
+std::vector<Session> gBatchSessions; // copies of the sessions of the senders in the batch
+
+// follows /targetMode and /target through the batch to find the display
+// each message is for, on a copy of the session of its sender. args is left
+// after the targets of the message
+static uint32_t getBatchTargets(const OscMessageView& msg, OscMessageView::ArgReader& args, Session& session)
+{
+	int n;
+	if(msg.match("/targetMode"))
+	{
+		if(args.popNumber(n).isOkNoMoreArgs() && n >= kTargetSingle && n <= kTargetStateful)
+			session.mode = (TargetMode)n;
+		return 0;
+	}
+	if(msg.match("/target"))
+	{
+		uint32_t targets = 0;
+		uint32_t t;
+		while(args.nbArgRemaining() && (t = popTargets(args)))
+			targets |= t;
+		if(kTargetStateful == session.mode && targets && args.isOkNoMoreArgs())
+			session.targets = targets;
+		return 0;
+	}
+	if(kTargetEach == session.mode)
+		return popTargets(args);
+	return session.targets;
+}
+
+static Session& getBatchSession(const OscBatchReceiver::Peer& peer)
+{
+	for(auto& session : gBatchSessions)
+	{
+		if(session.peer == peer)
+			return session;
+	}
+	gBatchSessions.push_back(getSession(peer));
+	return gBatchSessions.back();
+}
+
+// parse all the messages of a batch of packets, drop the superseded ones
+// and process the others in order
+static void processPackets(const std::vector<OscBatchReceiver::Packet>& packets)
+{
+	gBatch.clear();
+	gBatchSessions.clear();
+	for(auto& packet : packets)
+	{
+		// a malformed packet is dropped altogether
+		size_t batchSize = gBatch.size();
+		Session& session = getBatchSession(packet.peer);
+		Session packetSession = session;
+		if(!OscMessageView::parsePacket(packet.data, packet.size, [&](const OscMessageView& msg) {
+			OscMessageView::ArgReader args = msg.arg();
+			uint32_t targets = getBatchTargets(msg, args, session);
+			bool canSupersede = targets && isSnapshotMessage(msg) && hasSnapshotArgs(msg, args);
+			gBatch.push_back({msg, &packet, targets, canSupersede, false});
+		}))
+		{
+			fprintf(stderr, "Malformed OSC packet from %s\n", packet.from);
+			gBatch.resize(batchSize);
+			session = packetSession;
+		}
+	}
+	for(size_t n = 0; n < gBatch.size(); ++n)
+	{
+		BatchMessage& m = gBatch[n];
+		if(!m.targets || !isSnapshotMessage(m.msg))
+			continue;
+		for(size_t k = n + 1; k < gBatch.size(); ++k)
+		{
+			// superseded when a later one draws to all of its displays
+			if(gBatch[k].canSupersede && !(m.targets & ~gBatch[k].targets) && gBatch[k].msg.addressPattern() == m.msg.addressPattern())
+			{
+				m.superseded = true;
+				break;
+			}
+		}
+	}
+	gBatchRemaining = 0;
+	for(auto& m : gBatch)
+		gBatchRemaining += !m.superseded;
+	for(auto& m : gBatch)
+	{
+		if(m.superseded)
+			continue;
+		--gBatchRemaining;
+		parseMessage(m.msg, *m.packet);
+	}
+}
+
+// true if what is drawn to a and b ends up the same in their buffers
+static bool isSameBuffer(U8G2& a, U8G2& b)
+{
+	u8g2_t* ua = a.getU8g2();
+	u8g2_t* ub = b.getU8g2();
+	return ua->cb == ub->cb && !ua->gray == !ub->gray
+		&& a.getBufferTileWidth() == b.getBufferTileWidth()
+		&& a.getBufferTileHeight() == b.getBufferTileHeight();
+}
+
 int main(int main_argc, char *main_argv[])
 {
-	if(0 == gDisplays.size())
+	if(0 == gDisplays.size() || gDisplays.size() > kMaxTargets)
 	{
-		fprintf(stderr, "No displays in gDisplays\n");
+		fprintf(stderr, "There should be between 1 and %u displays in gDisplays\n", kMaxTargets);
 		return 1;
 	}
-#ifdef I2C_MUX
-	if(gTca.initI2C_RW(gI2cBus, gMuxAddress, -1) || gTca.select(-1))
-	{
-		fprintf(stderr, "Unable to initialise the TCA9548A multiplexer. Are the address and bus correct?\n");
+	// Set up interrupt handler to catch Control-C and SIGTERM
+	signal(SIGINT, interrupt_handler);
+	signal(SIGTERM, interrupt_handler);
+	// OSC is set up first, so that messages are received while the displays
+	// are being initialised
+	if(oscReceiver.setup(gLocalPort))
+		return 1;
+	if(gLocalStreamPort && oscReceiver.setupTcp(gLocalStreamPort, gStreamFraming))
+		return 1;
+	if(gLocalSocketPath && oscReceiver.setupUnix(gLocalSocketPath, gStreamFraming))
 		return 1;
+	for(unsigned int n = 0; n < gMuxes.size(); ++n)
+	{
+		Mux& mux = gMuxes[n];
+		if(mux.parent >= int(n) || (mux.parent >= 0 && (gMuxes[mux.parent].bus != mux.bus || mux.channel < 0 || mux.channel > 7)))
+		{
+			fprintf(stderr, "Mux %u should be on a bus, or behind a channel of a mux on the same bus which is listed before it\n", n);
+			return 1;
+		}
+		getBus(mux.bus);
 	}
-#endif // I2C_MUX
 	for(unsigned int n = 0; n < gDisplays.size(); ++n)
 	{
-		switchTarget(n);
-		U8G2& u8g2 = gDisplays[gActiveTarget].d;
-#ifndef I2C_MUX
-		int mux = gDisplays[gActiveTarget].mux;
-		if(-1 != mux)
+		Display& display = gDisplays[n];
+		if(display.d.isCanvas())
+			continue;
+		unsigned int number = u8x8_GetI2CBus(display.d.getU8x8());
+		if(display.mux >= int(gMuxes.size()) || (display.mux >= 0 && (gMuxes[display.mux].bus != number || display.channel < 0 || display.channel > 7)))
 		{
-			fprintf(stderr, "Display %u requires mux %d but I2C_MUX is disabled\n", n, mux);
+			fprintf(stderr, "Display %u should be on bus %u or behind a channel of a mux on it\n", n, number);
 			return 1;
 		}
-#endif // I2C_MUX
-		u8g2.initDisplay();
-		u8g2.setPowerSave(0);
-		u8g2.clearBuffer();
+		Bus& bus = getBus(number);
+		display.bus = &bus - gBuses.data();
+		bus.displays.push_back(n);
+	}
+	for(auto& mux : gMuxes)
+	{
+		if(mux.tca.initI2C_RW(mux.bus, mux.address, -1))
+		{
+			fprintf(stderr, "Unable to open the multiplexer at 0x%x on bus %u\n", mux.address, mux.bus);
+			return 1;
+		}
+	}
+	// this disables all the channels, one segment after the other
+	for(auto& mux : gMuxes)
+	{
+		if(route(getBus(mux.bus), mux.parent, mux.channel))
+		{
+			fprintf(stderr, "Unable to initialise the TCA9548A multiplexer at 0x%x on bus %u. Are the addresses and buses correct?\n", mux.address, mux.bus);
+			return 1;
+		}
+	}
+	for(auto& panel : gPanels)
+	{
+		if(panel.wall >= gDisplays.size() || panel.display >= gDisplays.size())
+		{
+			fprintf(stderr, "Panel %u of wall %u is not in gDisplays\n", panel.display, panel.wall);
+			return 1;
+		}
+		U8G2LinuxI2C& wall = gDisplays[panel.wall].d;
+		U8G2LinuxI2C& d = gDisplays[panel.display].d;
+		u8g2_t* u8g2 = d.getU8g2();
+		if(!wall.isCanvas() || d.isCanvas())
+		{
+			fprintf(stderr, "Wall %u should be a canvas and panel %u a display\n", panel.wall, panel.display);
+			return 1;
+		}
+		// rotations other than 180 degrees are done when the panel is sent
+		if(u8g2->gray || (U8G2_R0 != u8g2->cb && U8G2_R2 != u8g2->cb))
+		{
+			fprintf(stderr, "Panel %u should be a monochrome display with rotate at flush for U8G2_R1 and U8G2_R3\n", panel.display);
+			return 1;
+		}
+		if(panel.x % 8 || panel.y % 8
+			|| panel.x / 8 + d.getBufferTileWidth() > wall.getBufferTileWidth()
+			|| panel.y / 8 + d.getBufferTileHeight() > wall.getBufferTileHeight())
+		{
+			fprintf(stderr, "Panel %u at %u,%u should be at a multiple of 8 pixels and inside wall %u\n", panel.display, panel.x, panel.y, panel.wall);
+			return 1;
+		}
+	}
+	gShouldSend.resize(gDisplays.size());
+	// the splash screen is drawn once for each kind of display and copied
+	// into the others
+	for(unsigned int n = 0; n < gDisplays.size(); ++n)
+	{
+		U8G2LinuxI2C& u8g2 = gDisplays[n].d;
+		if(u8g2.isCanvas())
+			continue;
 		u8g2.setFont(u8g2_font_4x6_tf);
 		u8g2.setFontRefHeightText();
 		u8g2.setFontPosTop();
-		u8g2.drawStr(0, 0, " ____  _____ _        _");
-		u8g2.drawStr(0, 7, "| __ )| ____| |      / \\");
-		u8g2.drawStr(0, 14, "|  _ \\|  _| | |     / _ \\");
-		u8g2.drawStr(0, 21, "| |_) | |___| |___ / ___ \\");
-		u8g2.drawStr(0, 28, "|____/|_____|_____/_/   \\_\\");
-		if(gDisplays.size() > 1)
+		U8G2LinuxI2C* drawn = nullptr;
+		for(unsigned int k = 0; k < n && !drawn; ++k)
+		{
+			U8G2LinuxI2C& other = gDisplays[k].d;
+			if(!other.isCanvas() && isSameBuffer(other, u8g2))
+				drawn = &other;
+		}
+		if(drawn)
+			memcpy(u8g2.getBufferPtr(), drawn->getBufferPtr(), 8 * u8g2.getBufferTileWidth() * u8g2.getBufferTileHeight());
+		else {
+			u8g2.clearBuffer();
+			u8g2.drawStr(0, 0, " ____  _____ _        _");
+			u8g2.drawStr(0, 7, "| __ )| ____| |      / \\");
+			u8g2.drawStr(0, 14, "|  _ \\|  _| | |     / _ \\");
+			u8g2.drawStr(0, 21, "| |_) | |___| |___ / ___ \\");
+			u8g2.drawStr(0, 28, "|____/|_____|_____/_/   \\_\\");
+		}
+		gShouldSend[n] = true;
+	}
+	// the target IDs are drawn once the splash has been copied everywhere
+	for(unsigned int n = 0; n < gDisplays.size(); ++n)
+	{
+		if(gDisplays.size() > 1 && !gDisplays[n].d.isCanvas())
 		{
 			std::string targetString = "Target ID: " + std::to_string(n);
-			u8g2.drawStr(0, 50, targetString.c_str());
+			gDisplays[n].d.drawStr(0, 50, targetString.c_str());
 		}
-		u8g2.sendBuffer();
 	}
-	// Set up interrupt handler to catch Control-C and SIGTERM
-	signal(SIGINT, interrupt_handler);
-	signal(SIGTERM, interrupt_handler);
-	// OSC
-	oscReceiver.setup(gLocalPort, parseMessage);
+	// the displays are initialised in the background, all buses at the same
+	// time, and are sent to once their bus is ready
+	for(auto& bus : gBuses)
+		bus.worker->run([&bus]{ initBus(bus); });
+	bool effectsActive = false;
 	while(!gStop)
 	{
-		mtx.lock();
-		bool sent = false;
-		for(size_t n = 0; n < gShouldSend.size(); ++n)
+		// everything that arrived since the last iteration is processed at
+		// once, then the buses are sent to for a while if there is anything
+		// to send, which is taken in from the displays as it is
+		int timeoutMs = isFlushing() ? 0 : effectsActive ? gEffectsIntervalUs / 1000 : 50;
+		processPackets(oscReceiver.receive(timeoutMs));
+		splitWalls();
+		startFlushes();
+		flushBuses();
+		finishFlushes();
+		effectsActive = false;
+		uint64_t now = getTimeMs();
+		for(auto& display : gDisplays)
 		{
-			if(gShouldSend[n])
-			{
-				gDisplays[n].d.sendBuffer();
-				gShouldSend[n] = false;
-				sent = true;
-			}
+			// check back soon for displays which are still being initialised
+			if(!isReady(display))
+				effectsActive = true;
+			else
+				effectsActive |= processEffects(display, now);
 		}
-		mtx.unlock();
-		if(!sent)
-			usleep(50000);
 	}
+	// the buses may still be being initialised
+	for(auto& bus : gBuses)
+		bus.worker->wait();
 	return 0;
 }
@@ -3,6 +3,11 @@
 #endif // __linux__
 
 #include "cppsrc/U8g2lib.h"
+#include <vector>
+#include <memory>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
 
 extern "C" uint8_t u8x8_byte_linux_i2c(U8X8_UNUSED u8x8_t *u8x8, U8X8_UNUSED uint8_t msg, U8X8_UNUSED uint8_t arg_int, U8X8_UNUSED void *arg_ptr);
 extern "C" uint8_t u8x8_linux_i2c_delay (u8x8_t * u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
@@ -10,11 +15,96 @@ extern "C" uint8_t u8x8_linux_i2c_delay (u8x8_t * u8x8, uint8_t msg, uint8_t arg
 typedef void (*u8g2_Setup_Func)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
 
 class U8G2LinuxI2C : public U8G2 {
-  public: U8G2LinuxI2C(const u8g2_cb_t *rotation, uint8_t bus, uint8_t address, u8g2_Setup_Func setupFunc) {
+  public: U8G2LinuxI2C(const u8g2_cb_t *rotation, uint8_t bus, uint8_t address, u8g2_Setup_Func setupFunc, bool useGray = false) {
     setupFunc(&u8g2, rotation, u8x8_byte_linux_i2c, u8x8_linux_i2c_delay);
     setI2CBus(bus);
     setI2CAddress(address);
+    // the setup functions return a static buffer shared by all displays of
+    // the same size: give each instance its own
+    frameBufferSize = 8 * getBufferTileWidth() * getBufferTileHeight();
+    allocateFrameBuffer(nullptr);
+    if(useGray) {
+      // 16 level displays get a 4bpp image (and its RAM copy), each four
+      // times the size of the buffer. Only the changed rectangles are sent
+      shadow.resize(8 * frameBufferSize);
+      if(!u8g2_SetupGray(&u8g2, &gray, shadow.data()))
+        shadow.clear();
+    } else {
+      // only the changed tiles are sent. Rotated displays are drawn unrotated
+      // and transposed when the buffer is sent
+      shadow.resize(2 * frameBufferSize);
+      if(!u8g2_SetupFlushRotation(&u8g2, rotation, &flushRotation, shadow.data()))
+        shadow.clear();
+    }
   }
+  // a canvas of tileWidth x tileHeight tiles which is not connected to a
+  // display, to be split into the buffers of other displays with
+  // copyBufferTiles() (video wall)
+  U8G2LinuxI2C(const u8g2_cb_t *rotation, uint8_t tileWidth, uint8_t tileHeight) : canvasInfo(new u8x8_display_info_t) {
+    frameBufferSize = 8 * tileWidth * tileHeight;
+    allocateFrameBuffer(nullptr);
+    u8g2_SetupCanvas(&u8g2, canvasInfo.get(), tileWidth, tileHeight, frameBuffer.get(), rotation);
+  }
+  bool isCanvas() const { return canvasInfo != nullptr; }
+  U8G2LinuxI2C(const U8G2LinuxI2C& other) : U8G2(other), shadow(other.shadow), flushRotation(other.flushRotation), gray(other.gray), frameBufferSize(other.frameBufferSize), canvasInfo(other.canvasInfo) {
+    allocateFrameBuffer(other.frameBuffer.get());
+    relinkFlushRotation();
+    relinkGray();
+  }
+  U8G2LinuxI2C& operator=(const U8G2LinuxI2C& other) {
+    if(this == &other)
+      return *this;
+    U8G2::operator=(other);
+    shadow = other.shadow;
+    flushRotation = other.flushRotation;
+    gray = other.gray;
+    frameBufferSize = other.frameBufferSize;
+    canvasInfo = other.canvasInfo;
+    allocateFrameBuffer(other.frameBuffer.get());
+    relinkFlushRotation();
+    relinkGray();
+    return *this;
+  }
+  private:
+  static constexpr size_t kCacheLineSize = 64;
+  struct FreeDeleter {
+    void operator()(uint8_t* ptr) { free(ptr); }
+  };
+  // allocate a cache-line aligned buffer, optionally with a copy of the content of src
+  void allocateFrameBuffer(const uint8_t* src) {
+    void* ptr = nullptr;
+    size_t size = (frameBufferSize + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+    if(posix_memalign(&ptr, kCacheLineSize, size))
+      throw std::bad_alloc();
+    frameBuffer.reset((uint8_t*)ptr);
+    if(src)
+      memcpy(frameBuffer.get(), src, frameBufferSize);
+    else
+      memset(frameBuffer.get(), 0, frameBufferSize);
+    u8g2.tile_buf_ptr = frameBuffer.get();
+  }
+  // the u8g2 struct points into this object: fix the pointers after a copy
+  void relinkFlushRotation() {
+    if(!u8g2.flush_rotation)
+      return;
+    u8g2.flush_rotation = &flushRotation;
+    u8g2.u8x8.display_info = &flushRotation.display_info;
+    flushRotation.image = shadow.data();
+    flushRotation.ram = shadow.data() + frameBufferSize;
+  }
+  void relinkGray() {
+    if(!u8g2.gray)
+      return;
+    u8g2.gray = &gray;
+    gray.image = shadow.data();
+    gray.ram = shadow.data() + 4 * frameBufferSize;
+  }
+  std::vector<uint8_t> shadow;
+  u8g2_flush_rotation_t flushRotation;
+  u8g2_gray_t gray;
+  std::unique_ptr<uint8_t, FreeDeleter> frameBuffer;
+  size_t frameBufferSize;
+  std::shared_ptr<u8x8_display_info_t> canvasInfo; // the canvas size, shared by copies
 };
 
 class U8G2_SH1106_128X64_NONAME_F_HW_I2C_LINUX : public U8G2LinuxI2C {
@@ -34,3 +124,15 @@ class U8G2_SSD1309_128X64_NONAME2_F_HW_I2C_LINUX : public U8G2LinuxI2C {
     U8G2LinuxI2C(rotation, bus, address, u8g2_Setup_ssd1309_i2c_128x64_noname2_f)
   { }
 };
+
+class U8G2_SSD1327_MIDAS_128X128_F_HW_I2C_LINUX : public U8G2LinuxI2C {
+  public: U8G2_SSD1327_MIDAS_128X128_F_HW_I2C_LINUX(const u8g2_cb_t *rotation, uint8_t bus, uint8_t address) :
+    U8G2LinuxI2C(rotation, bus, address, u8g2_Setup_ssd1327_i2c_midas_128x128_f, true)
+  { }
+};
+
+class U8G2_SSD1327_WS_128X128_F_HW_I2C_LINUX : public U8G2LinuxI2C {
+  public: U8G2_SSD1327_WS_128X128_F_HW_I2C_LINUX(const u8g2_cb_t *rotation, uint8_t bus, uint8_t address) :
+    U8G2LinuxI2C(rotation, bus, address, u8g2_Setup_ssd1327_i2c_ws_128x128_f, true)
+  { }
+};
@@ -14,13 +14,12 @@
 
 #define BUFSIZ_I2C 32
 
-char filename[255];
-uint8_t data[BUFSIZ_I2C]; // just to be sure
-int idx = 0;
-// almost certainly the wrong place for this state!
-
+// all the state is per display, so that displays on different buses can
+// be flushed concurrently from different threads
 typedef struct {
     int file;
+    uint8_t data[BUFSIZ_I2C]; // just to be sure
+    int idx;
 } LinuxI2cPrivate_t;
 
 uint8_t
@@ -29,27 +28,35 @@ u8x8_byte_linux_i2c(u8x8_t *u8x8,
 		    uint8_t arg_int,
 		    void *arg_ptr)
 {
+	LinuxI2cPrivate_t* ptr = u8x8->private_state;
 	switch(msg){
 	case U8X8_MSG_BYTE_SEND:
 		//fprintf(stderr, "-- %d bytes:\n", arg_int);
-		for(int i = 0; i < arg_int && idx < BUFSIZ_I2C; i++, idx++){
-			data[idx] = *(uint8_t *)(arg_ptr+i);
-			//fprintf(stderr, "    %d  %d:  %0x\n", i, idx, data[idx]);
+		for(int i = 0; i < arg_int && ptr->idx < BUFSIZ_I2C; i++, ptr->idx++){
+			ptr->data[ptr->idx] = *(uint8_t *)(arg_ptr+i);
+			//fprintf(stderr, "    %d  %d:  %0x\n", i, ptr->idx, ptr->data[ptr->idx]);
 		}
 		break;
 	case U8X8_MSG_BYTE_INIT:
 	{
-                //TODO: ensure we free resources if this is a repeated init
                 //TOOD: add cleanup
-                LinuxI2cPrivate_t* ptr = calloc(1, sizeof(LinuxI2cPrivate_t));
-                if(!ptr) {
-                    fprintf(stderr, "Cannot allocate memory for LinuxI2cPrivate_t\n");
-                    return 1;
+                if(ptr) {
+                    // repeated init: reuse the state and reopen the device
+                    close(ptr->file);
+                    memset(ptr, 0, sizeof(LinuxI2cPrivate_t));
+                } else {
+                    ptr = calloc(1, sizeof(LinuxI2cPrivate_t));
+                    if(!ptr) {
+                        fprintf(stderr, "Cannot allocate memory for LinuxI2cPrivate_t\n");
+                        return 1;
+                    }
+                    u8x8->private_state = ptr;
                 }
-                u8x8->private_state = ptr;
+                ptr->file = -1;
+		char filename[20];
 		int addr = u8x8_GetI2CAddress(u8x8);
 		// ths open/setup? it seems to be a one-time setup
-		snprintf(filename, 19, "/dev/i2c-%d", u8x8_GetI2CBus(u8x8));
+		snprintf(filename, sizeof(filename), "/dev/i2c-%d", u8x8_GetI2CBus(u8x8));
 		int file = open(filename, O_RDWR);
 		if (file < 0) {
 			fprintf(stderr, "can't open i2c\n");
@@ -70,17 +77,16 @@ u8x8_byte_linux_i2c(u8x8_t *u8x8,
 		break;
 	case U8X8_MSG_BYTE_START_TRANSFER:
 		//fprintf(stderr, "++ start transfer, resetting buffers\n");
-		memset(data, 0, BUFSIZ_I2C);
-		idx = 0;
+		memset(ptr->data, 0, BUFSIZ_I2C);
+		ptr->idx = 0;
 		break;
 	case U8X8_MSG_BYTE_END_TRANSFER:
-		//fprintf(stderr, "++ end transfer, sending cmd %0x %0x count %d\n", data[0], data[1], idx);
+		//fprintf(stderr, "++ end transfer, sending cmd %0x %0x count %d\n", ptr->data[0], ptr->data[1], ptr->idx);
 		// NB! note the extre _i2c_ in there! leave that out and you are screwed
 		errno = 0;
-               LinuxI2cPrivate_t* ptr = u8x8->private_state;
-		if (write(ptr->file, data, idx) != idx) {
+		if (write(ptr->file, ptr->data, ptr->idx) != ptr->idx) {
 		//if (i2c_smbus_write_i2c_block_data(file, data[0], idx - 1, &data[1]) < 0) {
-			fprintf(stderr, "can't write cmd %0x: %s\n", data[0], strerror(errno));
+			fprintf(stderr, "can't write cmd %0x: %s\n", ptr->data[0], strerror(errno));
 			return(errno); 
 		}
 		break;
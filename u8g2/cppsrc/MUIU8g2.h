@@ -77,7 +77,11 @@ class MUIU8G2
     void sendSelect(void) { mui_SendSelect(&mui); }
     
     void sendSelectWithExecuteOnSelectFieldSearch(void) { mui_SendSelectWithExecuteOnSelectFieldSearch(&mui); }
+    void sendValueIncrement(void) { mui_SendValueIncrement(&mui); }
+    void sendValueDecrement(void) { mui_SendValueDecrement(&mui); }
     
+    void drawForm(mui_u8g2_form_areas_t *areas) { mui_u8g2_DrawForm(&mui, areas); }
+    void drawChanges(mui_u8g2_form_areas_t *areas, uint8_t id0 = 0, uint8_t id1 = 0) { mui_u8g2_DrawChanges(&mui, areas, id0, id1); }
     
     int isFormActive(void) { return mui_IsFormActive(&mui); }    
 };
@@ -135,6 +135,9 @@ class U8G2
 
     void setContrast(uint8_t value) {
       u8g2_SetContrast(&u8g2, value); }
+
+    uint8_t setPixelMode(uint8_t mode) {
+      return u8g2_SetPixelMode(&u8g2, mode); }
       
     void setDisplayRotation(const u8g2_cb_t *u8g2_cb) {
       u8g2_SetDisplayRotation(&u8g2, u8g2_cb); }
@@ -188,6 +191,11 @@ class U8G2
     void sendBuffer(void) { u8g2_SendBuffer(&u8g2); }
     void clearBuffer(void) { u8g2_ClearBuffer(&u8g2); }    
     
+    uint8_t scrollFlushRotation(u8g2_int_t dx, u8g2_int_t dy) { return u8g2_ScrollFlushRotation(&u8g2, dx, dy); }
+    void setGrayLevel(uint8_t level) { u8g2_SetGrayLevel(&u8g2, level); }
+    void setMonoGrayLevel(uint8_t level) { u8g2_SetMonoGrayLevel(&u8g2, level); }
+    bool hasGray(void) { return u8g2.gray != NULL; }
+    
     void firstPage(void) { u8g2_FirstPage(&u8g2); }
     uint8_t nextPage(void) { return u8g2_NextPage(&u8g2); }
     
@@ -198,6 +206,12 @@ class U8G2
     uint8_t *getBufferPtr(void) { return u8g2_GetBufferPtr(&u8g2); }
     uint8_t getBufferTileHeight(void) { return u8g2_GetBufferTileHeight(&u8g2); }
     uint8_t getBufferTileWidth(void) { return u8g2_GetBufferTileWidth(&u8g2); }
+    // copy the tiles of src starting at srcTileX/srcTileY into this buffer, true if it has changed
+    bool copyBufferTiles(U8G2 &src, uint8_t srcTileX, uint8_t srcTileY) { return u8g2_CopyBufferTiles(&u8g2, src.getU8g2(), srcTileX, srcTileY); }
+    // send the buffer one page at a time, see u8g2_PrepareSendPages()
+    uint8_t prepareSendPages(void) { return u8g2_PrepareSendPages(&u8g2); }
+    uint16_t getPageBytes(uint8_t page) { return u8g2_GetPageBytes(&u8g2, page); }
+    uint16_t sendPage(uint8_t page) { return u8g2_SendPage(&u8g2, page); }
     uint8_t getPageCurrTileRow(void) { return u8g2_GetBufferCurrTileRow(&u8g2); }	// obsolete
     void setPageCurrTileRow(uint8_t row) { u8g2_SetBufferCurrTileRow(&u8g2, row); }	// obsolete
     uint8_t getBufferCurrTileRow(void) { return u8g2_GetBufferCurrTileRow(&u8g2); }
@@ -239,10 +253,15 @@ class U8G2
     void drawDisc(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t opt = U8G2_DRAW_ALL) { u8g2_DrawDisc(&u8g2, x0, y0, rad, opt); }     
     void drawEllipse(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t opt = U8G2_DRAW_ALL) { u8g2_DrawEllipse(&u8g2, x0, y0, rx, ry, opt); }
     void drawFilledEllipse(u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t opt = U8G2_DRAW_ALL) { u8g2_DrawFilledEllipse(&u8g2, x0, y0, rx, ry, opt); }    
+    void drawSpans(u8g2_uint_t x0, u8g2_uint_t y0, const u8g2_uint_t *spans, u8g2_uint_t ry, uint8_t opt = U8G2_DRAW_ALL, uint8_t is_filled = 0) { u8g2_DrawSpans(&u8g2, x0, y0, spans, ry, opt, is_filled); }
 
     /* u8g2_line.c */
     void drawLine(u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2) 
       { u8g2_DrawLine(&u8g2, x1, y1, x2, y2); }
+    void drawPixels(const u8g2_xy_t *points, uint16_t cnt)
+      { u8g2_DrawPixels(&u8g2, points, cnt); }
+    void drawPolyline(const u8g2_xy_t *points, uint16_t cnt)
+      { u8g2_DrawPolyline(&u8g2, points, cnt); }
 
     /* u8g2_bitmap.c */
     void setBitmapMode(uint8_t is_transparent) 
@@ -258,9 +277,13 @@ class U8G2
     /* u8g2_polygon.c */
     void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2) 
       { u8g2_DrawTriangle(&u8g2, x0, y0, x1, y1, x2, y2); }
+    /* edges: working area with cnt elements, may be NULL for cnt <= U8G2_PG_STACK_EDGES */
+    void drawFilledPolygon(const u8g2_xy_t *points, uint16_t cnt, u8g2_pg_edge_t *edges = NULL)
+      { u8g2_DrawFilledPolygon(&u8g2, points, cnt, edges); }
       
     /* u8log_u8g2.c */
     void drawLog(u8g2_uint_t x, u8g2_uint_t y, class U8G2LOG &u8g2log);
+    void drawLogChanges(u8g2_uint_t x, u8g2_uint_t y, class U8G2LOG &u8g2log);
     
     /* u8g2_font.c */
 
@@ -465,6 +488,11 @@ inline void U8G2::drawLog(u8g2_uint_t x, u8g2_uint_t y, class U8G2LOG &u8g2log)
   u8g2_DrawLog(&u8g2, x, y, &(u8g2log.u8log)); 
 }
 
+inline void U8G2::drawLogChanges(u8g2_uint_t x, u8g2_uint_t y, class U8G2LOG &u8g2log)
+{
+  u8g2_DrawLogChanges(&u8g2, x, y, &(u8g2log.u8log)); 
+}
+
 
 /* 
   U8G2_<controller>_<display>_<memory>_<communication> 
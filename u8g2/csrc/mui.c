@@ -651,6 +651,16 @@ void mui_Draw(mui_t *ui)
   mui_loop_over_form(ui, mui_task_draw);
 }
 
+/*
+  Gives access to the loop over the fields of the current form, so that 
+  graphics specific code can draw only some of the fields.
+  WARNING: This function will destroy current fds and field information.
+*/
+void mui_LoopOverForm(mui_t *ui, uint8_t (*task)(mui_t *ui))
+{
+  mui_loop_over_form(ui, task);
+}
+
 void mui_next_field(mui_t *ui)
 {
   mui_loop_over_form(ui, mui_task_find_next_cursor_uif);
@@ -576,6 +576,8 @@ uint8_t mui_fds_get_token_cnt(mui_t *ui) MUI_NOINLINE;
 void mui_Init(mui_t *ui, void *graphics_data, fds_t *fds, muif_t *muif_tlist, size_t muif_tcnt);
 uint8_t mui_GetCurrentCursorFocusPosition(mui_t *ui) ;
 void mui_Draw(mui_t *ui);
+/* call "task" for each field of the current form (described by ui->fds and the field variables) until it returns 1 */
+void mui_LoopOverForm(mui_t *ui, uint8_t (*task)(mui_t *ui));
 /* warning: The next function will overwrite the ui field variables like ui->arg, etc. 26 sep 2021: only ui->text is modified */
 uint8_t mui_GetSelectableFieldTextOption(mui_t *ui, fds_t *fds, uint8_t nth_token);
 /* warning: The next function will overwrite the ui field variables like ui->arg, etc 26 sep 2021: only ui->text is modified*/
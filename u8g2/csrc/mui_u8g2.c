@@ -2176,3 +2176,210 @@ uint8_t mui_u8g2_u16_list_goto_w1_pi(mui_t *ui, uint8_t msg)
   }
   return 0;
 }
+
+
+/*=========================================================================*/
+/* incremental redraw */
+
+static mui_u8g2_form_areas_t *mui_u8g2_get_form_areas(mui_t *ui)
+{
+  return (mui_u8g2_form_areas_t *)(mui_get_U8g2(ui)->area);
+}
+
+static mui_u8g2_field_area_t *mui_u8g2_find_field_area(mui_u8g2_form_areas_t *areas, fds_t *fds)
+{
+  uint8_t i;
+  for( i = 0; i < areas->cnt; i++ )
+    if ( areas->field[i].fds == fds )
+      return areas->field+i;
+  return NULL;
+}
+
+static void mui_u8g2_draw_field(mui_t *ui)
+{
+  muif_get_cb(ui->uif)(ui, MUIF_MSG_DRAW);
+}
+
+/* draw all fields and store the area of each field */
+static uint8_t mui_u8g2_task_draw_form(mui_t *ui)
+{
+  mui_u8g2_form_areas_t *areas = mui_u8g2_get_form_areas(ui);
+  mui_u8g2_field_area_t *fa;
+  
+  areas->area.bbox_x0 = 0;
+  areas->area.bbox_x1 = 0;
+  mui_u8g2_draw_field(ui);
+  if ( areas->area.bbox_x0 == areas->area.bbox_x1 )
+    return 0;
+  if ( areas->cnt >= MUI_U8G2_FIELD_AREA_CNT )
+  {
+    areas->form_fds = NULL;     /* too many fields, always draw the complete form */
+    return 0;
+  }
+  fa = areas->field + areas->cnt;
+  areas->cnt++;
+  fa->fds = ui->fds;
+  fa->x0 = areas->area.bbox_x0;
+  fa->y0 = areas->area.bbox_y0;
+  fa->x1 = areas->area.bbox_x1;
+  fa->y1 = areas->area.bbox_y1;
+  return 0;
+}
+
+static uint8_t mui_u8g2_task_find_focus_id(mui_t *ui)
+{
+  mui_u8g2_form_areas_t *areas = mui_u8g2_get_form_areas(ui);
+  if ( ui->fds == ui->cursor_focus_fds )
+  {
+    areas->focus_id0 = ui->id0;
+    areas->focus_id1 = ui->id1;
+    return 1;
+  }
+  return 0;
+}
+
+static uint8_t mui_u8g2_task_find_changes(mui_t *ui)
+{
+  mui_u8g2_form_areas_t *areas = mui_u8g2_get_form_areas(ui);
+  if ( ui->fds == areas->cursor_focus_fds 
+    || ui->fds == ui->cursor_focus_fds 
+    || ( ui->id0 != 0 && ui->id0 == areas->id0 && ui->id1 == areas->id1 )
+    || ( ui->id0 != 0 && ui->id0 == areas->focus_id0 && ui->id1 == areas->focus_id1 ) )
+  {
+    if ( areas->changed_cnt >= MUI_U8G2_FIELD_AREA_CNT )
+    {
+      areas->form_fds = NULL;
+      return 1;
+    }
+    areas->changed_fds[areas->changed_cnt] = ui->fds;
+    areas->changed_cnt++;
+  }
+  return 0;
+}
+
+/* draw the target field or all fields, which overlap with the area; the style is always set */
+static uint8_t mui_u8g2_task_draw_changes(mui_t *ui)
+{
+  mui_u8g2_form_areas_t *areas = mui_u8g2_get_form_areas(ui);
+  mui_u8g2_field_area_t *fa;
+  
+  if ( ui->cmd == 'S' )
+  {
+    mui_u8g2_draw_field(ui);
+    return 0;
+  }
+  if ( areas->target_fds != NULL )
+  {
+    if ( ui->fds != areas->target_fds )
+      return 0;
+    mui_u8g2_draw_field(ui);
+    return 1;
+  }
+  fa = mui_u8g2_find_field_area(areas, ui->fds);
+  if ( fa == NULL || fa->x0 == fa->x1 )
+    return 0;
+  if ( fa->x0 < areas->area.x1 && fa->x1 > areas->area.x0 && fa->y0 < areas->area.y1 && fa->y1 > areas->area.y0 )
+    mui_u8g2_draw_field(ui);
+  return 0;
+}
+
+void mui_u8g2_DrawForm(mui_t *ui, mui_u8g2_form_areas_t *areas)
+{
+  u8g2_t *u8g2 = mui_get_U8g2(ui);
+  
+  areas->form_fds = ui->current_form_fds;
+  areas->cursor_focus_fds = ui->cursor_focus_fds;
+  areas->target_fds = NULL;
+  areas->cnt = 0;
+  u8g2_BeginArea(u8g2, &(areas->area), 0, 0, u8g2->pixel_buf_width, u8g2->pixel_buf_height);
+  mui_LoopOverForm(ui, mui_u8g2_task_draw_form);
+  u8g2_EndArea(u8g2);
+}
+
+void mui_u8g2_DrawChanges(mui_t *ui, mui_u8g2_form_areas_t *areas, uint8_t id0, uint8_t id1)
+{
+  u8g2_t *u8g2 = mui_get_U8g2(ui);
+  mui_u8g2_field_area_t *fa;
+  u8g2_uint_t x0, y0, x1, y1;
+  uint8_t i;
+  
+  if ( areas->form_fds != NULL && areas->form_fds == ui->current_form_fds )
+  {
+    /* measure only, until the areas are known */
+    u8g2_BeginArea(u8g2, &(areas->area), 0, 0, 0, 0);
+    areas->id0 = id0;
+    areas->id1 = id1;
+    areas->focus_id0 = 0;
+    areas->focus_id1 = 0;
+    areas->changed_cnt = 0;
+    areas->target_fds = NULL;
+    mui_LoopOverForm(ui, mui_u8g2_task_find_focus_id);
+    mui_LoopOverForm(ui, mui_u8g2_task_find_changes);
+    areas->cursor_focus_fds = ui->cursor_focus_fds;
+    
+    for( i = 0; i < areas->changed_cnt && areas->form_fds != NULL; i++ )
+    {
+      /* get the new area of the field */
+      areas->target_fds = areas->changed_fds[i];
+      u8g2_BeginArea(u8g2, &(areas->area), 0, 0, 0, 0);
+      mui_LoopOverForm(ui, mui_u8g2_task_draw_changes);
+      areas->target_fds = NULL;
+      
+      fa = mui_u8g2_find_field_area(areas, areas->changed_fds[i]);
+      if ( fa == NULL )
+      {
+        if ( areas->area.bbox_x0 == areas->area.bbox_x1 )
+          continue;     /* nothing drawn before and after */
+        if ( areas->cnt >= MUI_U8G2_FIELD_AREA_CNT )
+        {
+          areas->form_fds = NULL;
+          break;
+        }
+        fa = areas->field + areas->cnt;
+        areas->cnt++;
+        fa->fds = areas->changed_fds[i];
+        fa->x0 = 0;
+        fa->x1 = 0;
+      }
+      
+      /* the union of the old and the new area must be drawn again */
+      x0 = areas->area.bbox_x0;
+      y0 = areas->area.bbox_y0;
+      x1 = areas->area.bbox_x1;
+      y1 = areas->area.bbox_y1;
+      if ( x0 == x1 )
+      {
+        x0 = fa->x0;
+        y0 = fa->y0;
+        x1 = fa->x1;
+        y1 = fa->y1;
+      }
+      else if ( fa->x0 != fa->x1 )
+      {
+        if ( x0 > fa->x0 )
+          x0 = fa->x0;
+        if ( y0 > fa->y0 )
+          y0 = fa->y0;
+        if ( x1 < fa->x1 )
+          x1 = fa->x1;
+        if ( y1 < fa->y1 )
+          y1 = fa->y1;
+      }
+      fa->x0 = areas->area.bbox_x0;
+      fa->y0 = areas->area.bbox_y0;
+      fa->x1 = areas->area.bbox_x1;
+      fa->y1 = areas->area.bbox_y1;
+      if ( x0 == x1 )
+        continue;
+      
+      u8g2_BeginArea(u8g2, &(areas->area), x0, y0, x1, y1);
+      u8g2_ClearArea(u8g2);
+      mui_LoopOverForm(ui, mui_u8g2_task_draw_changes);
+    }
+    u8g2_EndArea(u8g2);
+    if ( areas->form_fds != NULL )
+      return;
+  }
+  u8g2_ClearBuffer(u8g2);
+  mui_u8g2_DrawForm(ui, areas);
+}
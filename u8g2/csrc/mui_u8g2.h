@@ -249,6 +249,50 @@ uint8_t mui_u8g2_u16_list_child_w1_pi(mui_t *ui, uint8_t msg);      /* GIF, MUIF
 uint8_t mui_u8g2_u16_list_goto_w1_pi(mui_t *ui, uint8_t msg);               /* REF, MUIF_U8G2_U16_LIST first char of the string denotes the target form */
 
 
+/*===== incremental redraw  =====*/
+
+/*
+  mui_u8g2_DrawForm() draws the current form like mui_Draw() and remembers 
+  the area of the buffer, which is covered by each field.
+  mui_u8g2_DrawChanges() draws only the fields, which might have changed since 
+  then: the fields, which lost or gained the cursor focus, all fields with the 
+  id of the focus field (a value might have changed) and all fields with the 
+  id id0/id1 (0/0 for none). The old and the new area of these fields is cleared 
+  and every field, which overlaps with it, is drawn again clipped to this area.
+  If another form is active, the buffer is cleared and the form is drawn again 
+  with mui_u8g2_DrawForm().
+  Both require a full buffer.
+*/
+#define MUI_U8G2_FIELD_AREA_CNT 32
+
+struct mui_u8g2_field_area_struct
+{
+  fds_t *fds;
+  u8g2_uint_t x0, y0, x1, y1;   /* buffer coordinates, empty if x0 == x1 */
+};
+
+typedef struct mui_u8g2_field_area_struct mui_u8g2_field_area_t;
+
+struct mui_u8g2_form_areas_struct
+{
+  u8g2_area_t area;        /* must be the first member, the field functions find this struct with u8g2->area */
+  fds_t *form_fds;        /* form of the field areas, NULL if the field areas are not valid */
+  fds_t *cursor_focus_fds;        /* cursor focus of the last draw */
+  fds_t *target_fds;        /* the only field, which is drawn, if not NULL */
+  uint8_t id0, id1;         /* id of the changed fields */
+  uint8_t focus_id0, focus_id1;
+  uint8_t cnt;
+  uint8_t changed_cnt;
+  mui_u8g2_field_area_t field[MUI_U8G2_FIELD_AREA_CNT];
+  fds_t *changed_fds[MUI_U8G2_FIELD_AREA_CNT];
+};
+
+typedef struct mui_u8g2_form_areas_struct mui_u8g2_form_areas_t;
+
+void mui_u8g2_DrawForm(mui_t *ui, mui_u8g2_form_areas_t *areas);
+void mui_u8g2_DrawChanges(mui_t *ui, mui_u8g2_form_areas_t *areas, uint8_t id0, uint8_t id1);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -218,11 +218,23 @@ typedef int16_t u8g2_long_t;		/* introduced for ellipse calculation */
 
 typedef struct u8g2_struct u8g2_t;
 typedef struct u8g2_cb_struct u8g2_cb_t;
+typedef struct u8g2_flush_rotation_struct u8g2_flush_rotation_t;
+typedef struct u8g2_gray_struct u8g2_gray_t;
+typedef struct u8g2_area_struct u8g2_area_t;
+
+/* point for polygons, polylines and pixel lists, may be outside of the display */
+struct _u8g2_xy_t
+{
+  int16_t x;
+  int16_t y;
+};
+typedef struct _u8g2_xy_t u8g2_xy_t;
 
 typedef void (*u8g2_update_dimension_cb)(u8g2_t *u8g2);
 typedef void (*u8g2_update_page_win_cb)(u8g2_t *u8g2);
 typedef void (*u8g2_draw_l90_cb)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 typedef void (*u8g2_draw_ll_hvline_cb)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+typedef void (*u8g2_draw_ll_box_cb)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
 
 typedef uint8_t (*u8g2_get_kerning_cb)(u8g2_t *u8g2, uint16_t e1, uint16_t e2);
 
@@ -315,7 +327,11 @@ struct u8g2_struct
 {
   u8x8_t u8x8;
   u8g2_draw_ll_hvline_cb ll_hvline;	/* low level hvline procedure */
+  u8g2_draw_ll_box_cb ll_box;		/* low level box procedure, NULL if not available for ll_hvline */
   const u8g2_cb_t *cb;		/* callback drawprocedures, can be replaced for rotation */
+  u8g2_flush_rotation_t *flush_rotation;	/* NULL if the buffer is sent without rotation */
+  u8g2_gray_t *gray;		/* NULL if there is no 4bpp image */
+  u8g2_area_t *area;		/* NULL if drawing is not restricted to an area */
   
   /* the following variables must be assigned during u8g2 setup */
   uint8_t *tile_buf_ptr;	/* ptr to memory area with u8x8.display_info->tile_width * 8 * tile_buf_height bytes */
@@ -407,6 +423,7 @@ struct u8g2_struct
 #define u8g2_SetPowerSave(u8g2, is_enable) u8x8_SetPowerSave(u8g2_GetU8x8(u8g2), (is_enable))
 #define u8g2_SetFlipMode(u8g2, mode) u8x8_SetFlipMode(u8g2_GetU8x8(u8g2), (mode))
 #define u8g2_SetContrast(u8g2, value) u8x8_SetContrast(u8g2_GetU8x8(u8g2), (value))
+#define u8g2_SetPixelMode(u8g2, mode) u8x8_SetPixelMode(u8g2_GetU8x8(u8g2), (mode))
 //#define u8g2_ClearDisplay(u8g2) u8x8_ClearDisplay(u8g2_GetU8x8(u8g2))  obsolete, can not be used in all cases
 void u8g2_ClearDisplay(u8g2_t *u8g2);
 
@@ -467,6 +484,7 @@ void u8g2_SendF(u8g2_t * u8g2, const char *fmt, ...);
 
 /* null device setup */
 void u8g2_Setup_null(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_SetupCanvas(u8g2_t *u8g2, u8x8_display_info_t *info, uint8_t tile_width, uint8_t tile_height, uint8_t *buf, const u8g2_cb_t *rotation);
 
 /*==========================================*/
 /* u8g2_d_memory.c generated code start */
@@ -1527,12 +1545,129 @@ void u8g2_Setup_a2printer_384x240_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x
 
 void u8g2_SendBuffer(u8g2_t *u8g2);
 void u8g2_ClearBuffer(u8g2_t *u8g2);
+uint8_t u8g2_ScrollBufferUp(u8g2_t *u8g2, u8g2_uint_t dy);	/* full vertical_top_lsb buffer only, returns 0 otherwise */
+uint8_t u8g2_CopyBufferTiles(u8g2_t *dest, u8g2_t *src, uint8_t src_tx, uint8_t src_ty);	/* returns 1 if dest has changed */
+
+/*
+  Send the buffer one page (display tile row) at a time, e.g. to share the
+  bus with other displays between the pages. u8g2_PrepareSendPages() takes
+  the content of the buffer and returns the number of pages, or 0 if the 
+  buffer is not a full buffer. u8g2_SendPage() then sends a page and 
+  returns the number of bytes of image data which have been sent, 
+  u8g2_GetPageBytes() returns how many it would send.
+  With rotate at flush and with a gray image only the changes are sent.
+  The buffer can be drawn to before all pages have been sent, if 
+  u8g2_PrepareSendPages() is called again before the next page: the 
+  changes which have not been sent yet are kept. Otherwise the pages are 
+  sent in full from the buffer.
+*/
+uint8_t u8g2_PrepareSendPages(u8g2_t *u8g2);
+uint16_t u8g2_GetPageBytes(u8g2_t *u8g2, uint8_t page);
+uint16_t u8g2_SendPage(u8g2_t *u8g2, uint8_t page);
 
 void u8g2_SetBufferCurrTileRow(u8g2_t *u8g2, uint8_t row) U8G2_NOINLINE;
 
 void u8g2_FirstPage(u8g2_t *u8g2);
 uint8_t u8g2_NextPage(u8g2_t *u8g2);
 
+/*
+  Rotate at flush: for U8G2_R1 and U8G2_R3 the picture is drawn without
+  rotation into a buffer with the rotated dimensions. Each tile is rotated
+  with an 8x8 bit transpose when the buffer is sent. U8G2_R0 is accepted
+  as well, then the tiles are copied.
+  Only tiles which differ from the previous content of the display RAM 
+  are transfered.
+  This requires a full buffer and a vertical_top_lsb buffer (SSD13xx, 
+  SH1106), "shadow" must have twice the size of the buffer. 
+  Returns 0 if rotate at flush is not possible, nothing is changed then.
+  
+  u8g2_ScrollFlushRotation() tells the flush, that the content of the buffer 
+  has moved by dx/dy pixels since the last send (negative values: to the 
+  left or to the top). If this is a movement along the vertical axis of the
+  controller, the display start line of the controller follows the movement 
+  and only the newly exposed rows of the display RAM are sent. A movement
+  of one pixel along the horizontal axis of the controller (dx for 
+  U8G2_R0) is done with U8X8_MSG_DISPLAY_SCROLL_COLUMN, then only the tiles
+  of the newly exposed column are sent. Larger horizontal movements are 
+  sent as usual: each column costs the controller a frame.
+  Returns 0 if this is not possible, the buffer is then sent as usual.
+*/
+#define U8G2_FLUSH_ROTATION_MAX_TILE_ROWS 32
+struct u8g2_flush_rotation_struct
+{
+  u8x8_display_info_t display_info;	/* display info with swapped width and height */
+  const u8x8_display_info_t *panel_info;	/* display info of the display controller */
+  u8x8_msg_cb display_cb;		/* display procedure of the display controller */
+  uint8_t *image;			/* rotated buffer in the layout of the display */
+  uint8_t *ram;			/* display RAM content, "image" shifted by the start line */
+  uint8_t rotation;			/* 0: U8G2_R0, 1: U8G2_R1, 3: U8G2_R3 */
+  uint8_t start_line;		/* display start line for the next send */
+  uint8_t sent_start_line;	/* display start line of the controller */
+  uint8_t is_ram_valid;		/* 0 after setup and display init: send all tiles */
+  int8_t scroll_x;			/* columns the buffer has moved to the right since the last send */
+  int8_t pending_scroll_x;	/* columns the RAM copy has moved, which are not sent to the controller yet */
+  uint8_t dirty_x0[U8G2_FLUSH_ROTATION_MAX_TILE_ROWS];	/* first changed tile of a display tile row */
+  uint8_t dirty_x1[U8G2_FLUSH_ROTATION_MAX_TILE_ROWS];	/* last changed tile + 1, 0 if there is no change */
+};
+uint8_t u8g2_SetupFlushRotation(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb, u8g2_flush_rotation_t *fr, uint8_t *shadow);
+uint8_t u8g2_ScrollFlushRotation(u8g2_t *u8g2, u8g2_int_t dx, u8g2_int_t dy);
+
+/*
+  4bpp gray image for 16 level controllers (SSD1327): next to the 1bpp 
+  buffer there is an image with two pixels per byte (left pixel in the 
+  upper nibble). u8g2_SetGrayLevel() redirects all draw procedures into 
+  the image, draw color 1 then draws with the given level (0..15), 
+  U8G2_GRAY_MONO draws into the 1bpp buffer again. When the buffer is
+  sent, the set pixels of the 1bpp buffer are shown over the image with 
+  the level of u8g2_SetMonoGrayLevel() (default 15) and only the changed 
+  rectangles are transfered. The image itself is not changed by this, so
+  pixels cleared in the 1bpp buffer disappear with the next send. 
+  u8g2_ClearBuffer() clears both.
+  This requires a full buffer, a vertical_top_lsb buffer, a display of at
+  most U8G2_GRAY_MAX_TILE_WIDTH tiles and a controller which supports 
+  U8X8_MSG_DISPLAY_DRAW_GRAY_AREA, "shadow" must have 
+  pixel_width*pixel_height bytes.
+  Returns 0 if this is not possible, nothing is changed then.
+*/
+#define U8G2_GRAY_MONO 255
+#define U8G2_GRAY_MAX_TILE_WIDTH 32
+struct u8g2_gray_struct
+{
+  u8x8_msg_cb display_cb;		/* display procedure of the display controller */
+  u8g2_draw_ll_hvline_cb mono_hvline;	/* low level procedures of the 1bpp buffer */
+  u8g2_draw_ll_box_cb mono_box;
+  uint8_t *image;			/* 4bpp image, rows of pixel_width/2 bytes */
+  uint8_t *ram;			/* display RAM content */
+  uint8_t level;			/* level of draw color 1 in the image */
+  uint8_t mono_level;		/* level of the pixels of the 1bpp buffer */
+  uint8_t is_ram_valid;		/* 0 after setup and display init: send everything */
+  uint8_t row[U8G2_GRAY_MAX_TILE_WIDTH*4];	/* one row of the image with the 1bpp buffer over it */
+};
+uint8_t u8g2_SetupGray(u8g2_t *u8g2, u8g2_gray_t *gray, uint8_t *shadow);
+void u8g2_SetGrayLevel(u8g2_t *u8g2, uint8_t level);
+void u8g2_SetMonoGrayLevel(u8g2_t *u8g2, uint8_t level);
+void u8g2_SendGray(u8g2_t *u8g2);
+
+/*
+  Draw area: u8g2_BeginArea() redirects the low level procedures, so that 
+  only the rectangle x0/y0 (included) to x1/y1 (excluded) of the buffer 
+  is modified. The bounding box of everything, which is drawn, is collected
+  in bbox_x0..bbox_y1 before it is clipped. An empty rectangle (x0 == x1)
+  only measures. Coordinates are buffer coordinates (after rotation).
+  u8g2_ClearArea() clears the rectangle, u8g2_EndArea() restores the 
+  low level procedures.
+*/
+struct u8g2_area_struct
+{
+  u8g2_draw_ll_hvline_cb ll_hvline;	/* procedures of the buffer */
+  u8g2_draw_ll_box_cb ll_box;
+  u8g2_uint_t x0, y0, x1, y1;
+  u8g2_uint_t bbox_x0, bbox_y0, bbox_x1, bbox_y1;	/* empty if bbox_x0 == bbox_x1 */
+};
+void u8g2_BeginArea(u8g2_t *u8g2, u8g2_area_t *area, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1);
+void u8g2_ClearArea(u8g2_t *u8g2);
+void u8g2_EndArea(u8g2_t *u8g2);
+
 // Add ability to set buffer pointer
 #ifdef __ARM_LINUX__
 #define U8G2_USE_DYNAMIC_ALLOC
@@ -1576,10 +1711,26 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
 /* ST7920 */
 void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 
+/*
+  x,y		Upper left position of the box within the local buffer (not the display!)
+  w,h		width and height of the box in pixel, both must not be 0
+  assumption: 
+    all clipping done
+*/
+#ifdef U8G2_WITH_HVLINE_SPEED_OPTIMIZATION
+/* SSD13xx, UC17xx, UC16xx */
+void u8g2_ll_box_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+/* SH1122, SSD1322, ST7920 */
+void u8g2_ll_box_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+#endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
+
 
 /*==========================================*/
 /* u8g2_hvline.c */
 
+/* clip a range from *ap with length *len against c (included) to d (excluded), returns 0 if there is no intersection */
+uint8_t u8g2_clip_intersection2(u8g2_uint_t *ap, u8g2_uint_t *len, u8g2_uint_t c, u8g2_uint_t d);
+
 /* u8g2_DrawHVLine does not use u8g2_IsIntersection */
 void u8g2_DrawHVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 
@@ -1597,6 +1748,8 @@ void u8g2_DrawHorizontalBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_
 void u8g2_DrawBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t cnt, u8g2_uint_t h, const uint8_t *bitmap);
 void u8g2_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
 void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);	/* assumes bitmap in PROGMEM */
+/* bit c of dst[r] is bit r of src[c], converts between XBM lines and vertical_top_lsb columns */
+void u8g2_Transpose8x8(uint8_t *dst, const uint8_t *src);
 
 
 /*==========================================*/
@@ -1618,10 +1771,22 @@ void u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t r
 void u8g2_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option);
 void u8g2_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
 void u8g2_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
+/*
+  span tables: spans[y] is the half width of the row y (0..ry) below the center,
+  spans must have ry+1 entries and ry must not exceed U8G2_MAX_SPAN_RADIUS.
+  A table can be reused for any position, option and draw color.
+*/
+#define U8G2_MAX_SPAN_RADIUS 255
+void u8g2_CalculateCircleSpans(u8g2_uint_t *spans, u8g2_uint_t rad);
+void u8g2_CalculateEllipseSpans(u8g2_uint_t *spans, u8g2_uint_t rx, u8g2_uint_t ry);
+void u8g2_DrawSpans(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, const u8g2_uint_t *spans, u8g2_uint_t ry, uint8_t option, uint8_t is_filled);
 
 /*==========================================*/
 /* u8g2_line.c */
 void u8g2_DrawLine(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2);
+/* draw "cnt" unconnected pixels or a line through all "cnt" points, clipping is done once per call */
+void u8g2_DrawPixels(u8g2_t *u8g2, const u8g2_xy_t *points, uint16_t cnt);
+void u8g2_DrawPolyline(u8g2_t *u8g2, const u8g2_xy_t *points, uint16_t cnt);
 
 
 /*==========================================*/
@@ -1669,6 +1834,30 @@ void u8g2_AddPolygonXY(u8g2_t *u8g2, int16_t x, int16_t y);
 void u8g2_DrawPolygon(u8g2_t *u8g2);
 void u8g2_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
 
+/* 
+  u8g2_DrawFilledPolygon: 
+    Fill any polygon with "cnt" points (even-odd rule). "edges" is a caller 
+    provided working area with "cnt" elements, it may be NULL if 
+    cnt <= U8G2_PG_STACK_EDGES. No global state is used.
+*/
+#define U8G2_PG_STACK_EDGES 16
+
+struct _u8g2_pg_edge_t
+{
+  int32_t x;		/* x position at the current scan line: x + rem/den */
+  int32_t rem;
+  int32_t den;
+  int32_t x_step;	/* x increment per scan line: x_step + rem_step/den */
+  int32_t rem_step;
+  int16_t x0;		/* upper end point of the edge */
+  int16_t x1;		/* lower end point of the edge */
+  int16_t y_min;	/* first scan line */
+  int16_t y_max;	/* scan line after the last scan line */
+};
+typedef struct _u8g2_pg_edge_t u8g2_pg_edge_t;
+
+void u8g2_DrawFilledPolygon(u8g2_t *u8g2, const u8g2_xy_t *points, uint16_t cnt, u8g2_pg_edge_t *edges);
+
 
 
 /*==========================================*/
@@ -1734,6 +1923,7 @@ void u8g2_SetFontRefHeightAll(u8g2_t *u8g2);
 /*==========================================*/
 /* u8log_u8g2.c */
 void u8g2_DrawLog(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log);
+void u8g2_DrawLogChanges(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log);
 void u8log_u8g2_cb(u8log_t * u8log);
 
 
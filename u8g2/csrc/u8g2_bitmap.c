@@ -35,6 +35,14 @@
 
 #include "u8g2.h"
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define U8G2_TRANSPOSE_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define U8G2_TRANSPOSE_SSE2
+#endif
+
 
 void u8g2_SetBitmapMode(u8g2_t *u8g2, uint8_t is_transparent) {
   u8g2->bitmap_transparency = is_transparent;
@@ -136,6 +144,186 @@ void u8g2_DrawHXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len,
 }
 
 
+/*
+  Transpose a 8x8 bit matrix: bit c of dst[r] is bit r of src[c]
+  With src being 8 rows of a XBM (lsb is the left pixel), dst will be the 
+  8 columns in the vertical_top_lsb format (lsb is the upper pixel) and vice versa.
+*/
+void u8g2_Transpose8x8(uint8_t *dst, const uint8_t *src)
+{
+#if defined(U8G2_TRANSPOSE_NEON)
+  static const uint8_t weight[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint8x8_t m = vld1_u8(src);
+  uint8x8_t wv = vld1_u8(weight);
+  uint8x8_t t[8];
+  uint8_t c;
+  
+  /* t[c]: lane r is (1<<r) if bit c of src[r] is set */
+  for( c = 0; c < 8; c++ )
+    t[c] = vand_u8(vtst_u8(m, vdup_n_u8(1 << c)), wv);
+  /* sum up the lanes of each t[c] */
+  t[0] = vpadd_u8(t[0], t[1]);
+  t[2] = vpadd_u8(t[2], t[3]);
+  t[4] = vpadd_u8(t[4], t[5]);
+  t[6] = vpadd_u8(t[6], t[7]);
+  t[0] = vpadd_u8(t[0], t[2]);
+  t[4] = vpadd_u8(t[4], t[6]);
+  vst1_u8(dst, vpadd_u8(t[0], t[4]));
+#elif defined(U8G2_TRANSPOSE_SSE2)
+  __m128i m = _mm_loadl_epi64((const __m128i *)src);
+  uint8_t c = 8;
+  
+  /* the msb of each byte is collected by movemask */
+  do
+  {
+    c--;
+    dst[c] = (uint8_t)_mm_movemask_epi8(m);
+    m = _mm_add_epi8(m, m);
+  } while( c > 0 );
+#else
+  uint64_t m = 0;
+  uint64_t t;
+  uint8_t i;
+  
+  for( i = 0; i < 8; i++ )
+    m |= (uint64_t)src[i] << (i*8);
+  /* Hacker's Delight, 7-3: swap 1x1, 2x2 and 4x4 blocks */
+  t = (m ^ (m >> 7)) & 0x00AA00AA00AA00AAULL;
+  m = m ^ t ^ (t << 7);
+  t = (m ^ (m >> 14)) & 0x0000CCCC0000CCCCULL;
+  m = m ^ t ^ (t << 14);
+  t = (m ^ (m >> 28)) & 0x00000000F0F0F0F0ULL;
+  m = m ^ t ^ (t << 28);
+  for( i = 0; i < 8; i++ )
+    dst[i] = (uint8_t)(m >> (i*8));
+#endif
+}
+
+#ifdef U8G2_WITH_HVLINE_SPEED_OPTIMIZATION
+
+/* apply "mask" with the given color to *ptr */
+static void u8g2_blit_byte(uint8_t *ptr, uint8_t mask, uint8_t color)
+{
+  if ( color == 0 )
+    *ptr &= ~mask;
+  else if ( color == 1 )
+    *ptr |= mask;
+  else
+    *ptr ^= mask;
+}
+
+/* read 8 pixel of a XBM line, starting at pixel x, pixel beyond blen bytes are 0 */
+static uint8_t u8g2_get_xbm_byte(const uint8_t *line, u8g2_uint_t blen, u8g2_uint_t x, uint8_t is_pgm)
+{
+  u8g2_uint_t pos = x >> 3;
+  uint8_t shift = x & 7;
+  uint8_t lo, hi = 0;
+  
+  lo = is_pgm ? u8x8_pgm_read(line + pos) : line[pos];
+  if ( shift == 0 )
+    return lo;
+  pos++;
+  if ( pos < blen )
+    hi = is_pgm ? u8x8_pgm_read(line + pos) : line[pos];
+  return (uint8_t)((lo >> shift) | (hi << (8 - shift)));
+}
+
+/*
+  Draw a XBM directly into a vertical_top_lsb buffer, 8x8 pixel at a time.
+  Each block of 8 XBM lines is transposed into 8 columns, shifted to the 
+  y position of the block and merged into (at most) two pages of the buffer.
+  Returns 0 if the bitmap can not be drawn here. In this case nothing has been drawn.
+*/
+static uint8_t u8g2_draw_xbm_blit(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap, uint8_t is_pgm)
+{
+  uint8_t src[8];
+  uint8_t col[8];
+  uint8_t *page;
+  u8g2_uint_t blen, cx, cy, cw, ch, sx, sy, bx, by, i, j;
+  uint16_t stride, v;
+  uint8_t rows, cols, r, c, shift, row_mask, bits;
+  uint8_t color = u8g2->draw_color;
+  uint8_t ncolor = (color == 0 ? 1 : 0);
+  uint8_t is_transparent = u8g2->bitmap_transparency;
+  
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb || u8g2->cb != U8G2_R0 )
+    return 0;
+
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return 1;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  if ( w == 0 || h == 0 )
+    return 1;
+
+  /* clip against the user window, sx/sy is the first visible pixel of the bitmap */
+  cx = x; cw = w;
+  cy = y; ch = h;
+  if ( u8g2_clip_intersection2(&cx, &cw, u8g2->user_x0, u8g2->user_x1) == 0 )
+    return 1;
+  if ( u8g2_clip_intersection2(&cy, &ch, u8g2->user_y0, u8g2->user_y1) == 0 )
+    return 1;
+  sx = cx - x;
+  sy = cy - y;
+  
+  blen = w;
+  blen += 7;
+  blen >>= 3;
+  
+  stride = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  stride *= 8;
+  by = cy - u8g2->pixel_curr_row;	/* position within the buffer */
+  
+  for( j = 0; j < ch; j += 8 )
+  {
+    rows = 8;
+    if ( ch - j < 8 )
+      rows = ch - j;
+    row_mask = 0x0ff >> (8 - rows);
+    shift = (by + j) & 7;
+    page = u8g2->tile_buf_ptr;
+    page += (uint16_t)((by + j) >> 3) * stride;
+    
+    for( i = 0; i < cw; i += 8 )
+    {
+      cols = 8;
+      if ( cw - i < 8 )
+	cols = cw - i;
+      for( r = 0; r < 8; r++ )
+      {
+	src[r] = 0;
+	if ( r < rows )
+	  src[r] = u8g2_get_xbm_byte(bitmap + (uint32_t)(sy + j + r) * blen, blen, sx + i, is_pgm);
+      }
+      u8g2_Transpose8x8(col, src);
+      
+      bx = cx + i;
+      for( c = 0; c < cols; c++ )
+      {
+	/* foreground pixel */
+	bits = col[c] & row_mask;
+	v = (uint16_t)bits << shift;
+	if ( v & 0x0ff )
+	  u8g2_blit_byte(page + bx + c, (uint8_t)v, color);
+	if ( v >> 8 )
+	  u8g2_blit_byte(page + stride + bx + c, (uint8_t)(v >> 8), color);
+	/* background pixel */
+	if ( is_transparent == 0 )
+	{
+	  bits = ~col[c] & row_mask;
+	  v = (uint16_t)bits << shift;
+	  if ( v & 0x0ff )
+	    u8g2_blit_byte(page + bx + c, (uint8_t)v, ncolor);
+	  if ( v >> 8 )
+	    u8g2_blit_byte(page + stride + bx + c, (uint8_t)(v >> 8), ncolor);
+	}
+      }
+    }
+  }
+  return 1;
+}
+#endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
+
 void u8g2_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
 {
   u8g2_uint_t blen;
@@ -146,6 +334,10 @@ void u8g2_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_HVLINE_SPEED_OPTIMIZATION
+  if ( u8g2_draw_xbm_blit(u8g2, x, y, w, h, bitmap, 0) != 0 )
+    return;
+#endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
   
   while( h > 0 )
   {
@@ -205,6 +397,10 @@ void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_HVLINE_SPEED_OPTIMIZATION
+  if ( u8g2_draw_xbm_blit(u8g2, x, y, w, h, bitmap, 1) != 0 )
+    return;
+#endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
   
   while( h > 0 )
   {
@@ -35,6 +35,65 @@
 
 #include "u8g2.h"
 
+#ifdef U8G2_WITH_HVLINE_SPEED_OPTIMIZATION
+/*
+  Clip the box against the user window, apply the display rotation and 
+  pass the box to the low level box procedure.
+  Returns 0 if the box could not be handled here (mirrored display or
+  no low level box procedure available). In this case nothing has been drawn.
+*/
+static uint8_t u8g2_draw_ll_box(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_uint_t xx, yy, ww, hh;
+  
+  if ( u8g2->ll_box == NULL )
+    return 0;
+  
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return 1;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+  /* clip against the user window */
+  if ( u8g2_clip_intersection2(&x, &w, u8g2->user_x0, u8g2->user_x1) == 0 )
+    return 1;
+  if ( u8g2_clip_intersection2(&y, &h, u8g2->user_y0, u8g2->user_y1) == 0 )
+    return 1;
+  
+  /* same transformation as in u8g2_draw_l90_rX() */
+  if ( u8g2->cb == U8G2_R0 )
+  {
+    xx = x; yy = y; ww = w; hh = h;
+  }
+  else if ( u8g2->cb == U8G2_R1 )
+  {
+    xx = u8g2->height; xx -= y; xx -= h;
+    yy = x; ww = h; hh = w;
+  }
+  else if ( u8g2->cb == U8G2_R2 )
+  {
+    xx = u8g2->width; xx -= x; xx -= w;
+    yy = u8g2->height; yy -= y; yy -= h;
+    ww = w; hh = h;
+  }
+  else if ( u8g2->cb == U8G2_R3 )
+  {
+    xx = y;
+    yy = u8g2->width; yy -= x; yy -= w;
+    ww = h; hh = w;
+  }
+  else
+  {
+    return 0;
+  }
+  
+  /* transform to pixel buffer coordinates */
+  yy -= u8g2->pixel_curr_row;
+  u8g2->ll_box(u8g2, xx, yy, ww, hh);
+  return 1;
+}
+#endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
+
 /*
   draw a filled box
   restriction: does not work for w = 0 or h = 0
@@ -45,6 +104,12 @@ void u8g2_DrawBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_HVLINE_SPEED_OPTIMIZATION
+  if ( w == 0 || h == 0 )
+    return;
+  if ( u8g2_draw_ll_box(u8g2, x, y, w, h) != 0 )
+    return;
+#endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
   while( h != 0 )
   { 
     u8g2_DrawHVLine(u8g2, x, y, w, 0);
@@ -36,6 +36,8 @@
 #include "u8g2.h"
 #include <string.h>
 
+static void u8g2_flush_rotation_send(u8x8_t *u8x8, u8g2_flush_rotation_t *fr);
+
 /*============================================*/
 void u8g2_ClearBuffer(u8g2_t *u8g2)
 {
@@ -44,25 +46,123 @@ void u8g2_ClearBuffer(u8g2_t *u8g2)
   cnt *= u8g2->tile_buf_height;
   cnt *= 8;
   memset(u8g2->tile_buf_ptr, 0, cnt);
+  /* the 4bpp image has four times the size of the full buffer */
+  if ( u8g2->gray != NULL )
+    memset(u8g2->gray->image, 0, cnt * 4);
 }
 
-/*============================================*/
+/*
+  Move the content of a full buffer up by dy pixel, the rows at the bottom 
+  are cleared. The rows are moved in the memory layout of the buffer, so 
+  this is an upward movement for U8G2_R0 and for rotate at flush.
+*/
+uint8_t u8g2_ScrollBufferUp(u8g2_t *u8g2, u8g2_uint_t dy)
+{
+  uint16_t stride = u8g2_GetU8x8(u8g2)->display_info->tile_width * 8;
+  uint8_t pages = u8g2->tile_buf_height;
+  uint8_t q, r, p;
+  uint8_t *dest;
+  const uint8_t *src;
+  uint16_t x;
+  
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+    return 0;
+  if ( u8g2->tile_buf_height != u8g2_GetU8x8(u8g2)->display_info->tile_height )
+    return 0;	/* not in full buffer mode */
+  if ( dy >= (u8g2_uint_t)pages * 8 )
+  {
+    u8g2_ClearBuffer(u8g2);
+    return 1;
+  }
+  
+  /* page p gets the upper part from page p+q and the lower part from page p+q+1 */
+  q = dy >> 3;
+  r = dy & 7;
+  for( p = 0; p < pages; p++ )
+  {
+    dest = u8g2->tile_buf_ptr + (uint16_t)p * stride;
+    if ( p + q >= pages )
+    {
+      memset(dest, 0, stride);
+      continue;
+    }
+    src = u8g2->tile_buf_ptr + (uint16_t)(p + q) * stride;
+    if ( r == 0 )
+    {
+      memmove(dest, src, stride);
+    }
+    else if ( p + q + 1 < pages )
+    {
+      for( x = 0; x < stride; x++ )
+	dest[x] = (src[x] >> r) | (src[x + stride] << (8 - r));
+    }
+    else
+    {
+      for( x = 0; x < stride; x++ )
+	dest[x] = src[x] >> r;
+    }
+  }
+  return 1;
+}
 
-static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_tile_row)
+static uint8_t u8g2_reverse_byte(uint8_t b)
 {
-  uint8_t *ptr;
-  uint16_t offset;
-  uint8_t w;
+  b = (b >> 4) | (b << 4);
+  b = ((b & 0xcc) >> 2) | ((b & 0x33) << 2);
+  b = ((b & 0xaa) >> 1) | ((b & 0x55) << 1);
+  return b;
+}
+
+/*
+  Copy the tiles of the buffer of "src" which start at tile src_tx/src_ty 
+  into the whole buffer of "dest", e.g. to split a canvas (see 
+  u8g2_SetupCanvas()) into the buffers of the displays it is made of.
+  If "dest" is drawn with U8G2_R2, the tiles are rotated by 180 degrees, 
+  other rotations of "dest" must be done at flush (rotate at flush).
+  Both buffers must be full vertical_top_lsb buffers and "src" must contain 
+  the whole area.
+  Returns 1 if the content of "dest" has changed.
+*/
+uint8_t u8g2_CopyBufferTiles(u8g2_t *dest, u8g2_t *src, uint8_t src_tx, uint8_t src_ty)
+{
+  uint16_t src_stride = u8g2_GetU8x8(src)->display_info->tile_width * 8;
+  uint16_t stride = u8g2_GetU8x8(dest)->display_info->tile_width * 8;
+  uint8_t pages = dest->tile_buf_height;
+  uint8_t changed = 0;
+  uint8_t p, b;
+  uint16_t x;
+  const uint8_t *s;
+  uint8_t *d;
   
-  w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
-  offset = src_tile_row;
-  ptr = u8g2->tile_buf_ptr;
-  offset *= w;
-  offset *= 8;
-  ptr += offset;
-  u8x8_DrawTile(u8g2_GetU8x8(u8g2), 0, dest_tile_row, w, ptr);
+  for( p = 0; p < pages; p++ )
+  {
+    s = src->tile_buf_ptr + (size_t)(src_ty + p) * src_stride + (uint16_t)src_tx * 8;
+    if ( dest->cb == U8G2_R2 )
+    {
+      /* the last row of dest, from right to left, with the bits mirrored */
+      d = dest->tile_buf_ptr + (uint16_t)(pages - 1 - p) * stride + stride - 1;
+      for( x = 0; x < stride; x++ )
+      {
+	b = u8g2_reverse_byte(s[x]);
+	changed |= *d ^ b;
+	*d-- = b;
+      }
+    }
+    else
+    {
+      d = dest->tile_buf_ptr + (uint16_t)p * stride;
+      if ( memcmp(d, s, stride) != 0 )
+      {
+	memcpy(d, s, stride);
+	changed = 1;
+      }
+    }
+  }
+  return changed != 0;
 }
 
+/*============================================*/
+
 /* 
   write the buffer to the display RAM. 
   For most displays, this will make the content visible to the user.
@@ -71,22 +171,22 @@ static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_
 static void u8g2_send_buffer(u8g2_t *u8g2) U8X8_NOINLINE;
 static void u8g2_send_buffer(u8g2_t *u8g2)
 {
-  uint8_t src_row;
-  uint8_t src_max;
+  uint8_t rows;
   uint8_t dest_row;
   uint8_t dest_max;
 
-  src_row = 0;
-  src_max = u8g2->tile_buf_height;
   dest_row = u8g2->tile_curr_row;
   dest_max = u8g2_GetU8x8(u8g2)->display_info->tile_height;
   
-  do
-  {
-    u8g2_send_tile_row(u8g2, src_row, dest_row);
-    src_row++;
-    dest_row++;
-  } while( src_row < src_max && dest_row < dest_max );
+  /* all rows of the buffer, which are visible on the display, but at least one */
+  rows = u8g2->tile_buf_height;
+  if ( dest_row + rows > dest_max )
+    rows = dest_max - dest_row;
+  if ( dest_row >= dest_max )
+    rows = 1;
+  
+  /* send all rows at once, if the display supports this */
+  u8x8_DrawTileArea(u8g2_GetU8x8(u8g2), 0, dest_row, u8g2_GetU8x8(u8g2)->display_info->tile_width, rows, u8g2->tile_buf_ptr);
 }
 
 /* same as u8g2_send_buffer but also send the DISPLAY_REFRESH message (used by SSD1606) */
@@ -165,13 +265,13 @@ void u8g2_UpdateDisplayArea(u8g2_t *u8g2, uint8_t  tx, uint8_t ty, uint8_t tw, u
   ptr += tx*8;
   ptr += page_size*ty;
   
-  while( th > 0 )
-  {
-    u8x8_DrawTile( u8g2_GetU8x8(u8g2), tx, ty, tw, ptr );
-    ptr += page_size;
-    ty++;
-    th--;
-  }  
+  u8x8_DrawTileArea( u8g2_GetU8x8(u8g2), tx, ty, tw, th, ptr );
+  
+  /* with rotate at flush, the tiles are only sent after the last tile row */
+  if ( u8g2->flush_rotation != NULL )
+    u8g2_flush_rotation_send( u8g2_GetU8x8(u8g2), u8g2->flush_rotation );
+  if ( u8g2->gray != NULL )
+    u8g2_SendGray(u8g2);
 }
 
 /* same as sendBuffer, but does not send the ePaper refresh message */
@@ -211,3 +311,753 @@ void u8g2_WriteBufferXBM2(u8g2_t *u8g2, void (*out)(const char *s))
   u8x8_capture_write_xbm_buffer(u8g2_GetBufferPtr(u8g2), u8g2_GetBufferTileWidth(u8g2), u8g2_GetBufferTileHeight(u8g2), u8x8_capture_get_pixel_2, out);
 }
 
+
+/*============================================*/
+/* rotate at flush */
+
+static uint8_t u8g2_reverse_bits(uint8_t b)
+{
+  b = (b >> 4) | (b << 4);
+  b = ((b >> 2) & 0x33) | ((b & 0x33) << 2);
+  b = ((b >> 1) & 0x55) | ((b & 0x55) << 1);
+  return b;
+}
+
+/* call the display procedure of the controller with the display info of the controller */
+static uint8_t u8g2_flush_rotation_forward(u8x8_t *u8x8, u8g2_flush_rotation_t *fr, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t result;
+  u8x8->display_info = fr->panel_info;
+  result = fr->display_cb(u8x8, msg, arg_int, arg_ptr);
+  u8x8->display_info = &fr->display_info;
+  return result;
+}
+
+/* rotate one tile of the buffer and store it in the image of the display */
+static void u8g2_flush_rotation_store_tile(u8g2_flush_rotation_t *fr, uint8_t tx, uint8_t ty, const uint8_t *src)
+{
+  uint8_t t[8];
+  uint8_t *dest;
+  uint8_t px, py, i;
+  
+  if ( fr->rotation == 0 )
+  {
+    memcpy(fr->image + ((uint16_t)ty * fr->panel_info->tile_width + tx) * 8, src, 8);
+    return;
+  }
+  
+  /* bit j of t[i] is bit i of src[j]: t[i] is the buffer row i */
+  u8g2_Transpose8x8(t, src);
+  if ( fr->rotation == 1 )
+  {
+    /* U8G2_R1: buffer x goes down, buffer y goes from right to left */
+    px = fr->panel_info->tile_width - 1 - ty;
+    py = tx;
+    dest = fr->image + ((uint16_t)py * fr->panel_info->tile_width + px) * 8;
+    for( i = 0; i < 8; i++ )
+      dest[i] = t[7-i];
+  }
+  else
+  {
+    /* U8G2_R3: buffer x goes up, buffer y goes from left to right */
+    px = ty;
+    py = fr->panel_info->tile_height - 1 - tx;
+    dest = fr->image + ((uint16_t)py * fr->panel_info->tile_width + px) * 8;
+    for( i = 0; i < 8; i++ )
+      dest[i] = u8g2_reverse_bits(t[i]);
+  }
+}
+
+/* 
+  move the RAM copy with a scroll of the buffer by one column, which is 
+  sent to the controller before the next tiles. Other scrolls are sent as
+  changes of the content 
+*/
+static void u8g2_flush_rotation_move_ram(u8g2_flush_rotation_t *fr)
+{
+  uint8_t tw = fr->panel_info->tile_width;
+  uint16_t stride = (uint16_t)tw * 8;
+  uint8_t *row;
+  uint8_t q;
+  
+  if ( fr->is_ram_valid != 0 && (fr->scroll_x == 1 || fr->scroll_x == -1) )
+  {
+    for( q = 0; q < fr->panel_info->tile_height; q++ )
+    {
+      /* 
+	the column which is moved in is unknown. Tiles which have not been 
+	sent yet move into their neighbours
+      */
+      row = fr->ram + (uint16_t)q * stride;
+      if ( fr->scroll_x > 0 )
+      {
+	memmove(row + 1, row, stride - 1);
+	if ( fr->dirty_x1[q] == 0 )
+	  fr->dirty_x1[q] = 1;
+	else if ( fr->dirty_x1[q] < tw )
+	  fr->dirty_x1[q]++;
+	fr->dirty_x0[q] = 0;
+      }
+      else
+      {
+	memmove(row, row + 1, stride - 1);
+	if ( fr->dirty_x1[q] == 0 )
+	  fr->dirty_x0[q] = tw - 1;
+	else if ( fr->dirty_x0[q] > 0 )
+	  fr->dirty_x0[q]--;
+	fr->dirty_x1[q] = tw;
+      }
+    }
+    fr->pending_scroll_x += fr->scroll_x;
+  }
+  fr->scroll_x = 0;
+}
+
+/* move the RAM of the controller like the RAM copy */
+static void u8g2_flush_rotation_send_scroll(u8x8_t *u8x8, u8g2_flush_rotation_t *fr)
+{
+  for( ; fr->pending_scroll_x > 0; fr->pending_scroll_x-- )
+    u8g2_flush_rotation_forward(u8x8, fr, U8X8_MSG_DISPLAY_SCROLL_COLUMN, U8X8_SCROLL_COLUMN_RIGHT, NULL);
+  for( ; fr->pending_scroll_x < 0; fr->pending_scroll_x++ )
+    u8g2_flush_rotation_forward(u8x8, fr, U8X8_MSG_DISPLAY_SCROLL_COLUMN, U8X8_SCROLL_COLUMN_LEFT, NULL);
+}
+
+/* 
+  shift the image by the start line into the RAM copy and find the changed tiles:
+  RAM line l is shown in display line l - start_line. 
+  Tiles which are still marked as changed (not sent yet) stay marked.
+*/
+static void u8g2_flush_rotation_update_ram(u8g2_flush_rotation_t *fr)
+{
+  uint8_t tw = fr->panel_info->tile_width;
+  uint8_t th = fr->panel_info->tile_height;
+  uint8_t shift = fr->start_line & 7;
+  uint8_t q, p, pm, x, i;
+  uint8_t t[8];
+  uint8_t *ram;
+  const uint8_t *src;
+  const uint8_t *src_prev;
+  
+  for( q = 0; q < th; q++ )
+  {
+    /* RAM page q contains the lower lines of display page p-1 and the upper lines of display page p */
+    p = (q + th - ((fr->start_line >> 3) % th)) % th;
+    pm = (p + th - 1) % th;
+    for( x = 0; x < tw; x++ )
+    {
+      src = fr->image + ((uint16_t)p * tw + x) * 8;
+      src_prev = fr->image + ((uint16_t)pm * tw + x) * 8;
+      for( i = 0; i < 8; i++ )
+      {
+	t[i] = src[i];
+	if ( shift != 0 )
+	  t[i] = (src[i] << shift) | (src_prev[i] >> (8 - shift));
+      }
+      ram = fr->ram + ((uint16_t)q * tw + x) * 8;
+      if ( fr->is_ram_valid != 0 && memcmp(ram, t, 8) == 0 )
+	continue;
+      memcpy(ram, t, 8);
+      if ( fr->dirty_x1[q] == 0 || x < fr->dirty_x0[q] )
+	fr->dirty_x0[q] = x;
+      if ( x + 1 > fr->dirty_x1[q] )
+	fr->dirty_x1[q] = x + 1;
+    }
+  }
+  fr->is_ram_valid = 1;
+}
+
+/* send all changed tiles, adjacent tile rows with the same changed range are sent as one area */
+static void u8g2_flush_rotation_send(u8x8_t *u8x8, u8g2_flush_rotation_t *fr)
+{
+  u8x8_tile_t tile;
+  uint8_t y, rows;
+  
+  if ( fr->start_line != u8x8->display_start_line )
+  {
+    /* the content of the RAM moves with the start line, the RAM copy is still valid */
+    if ( u8g2_flush_rotation_forward(u8x8, fr, U8X8_MSG_DISPLAY_SET_START_LINE, fr->start_line, NULL) == 0 )
+      fr->start_line = u8x8->display_start_line;	/* not supported by the controller */
+  }
+  u8g2_flush_rotation_move_ram(fr);
+  u8g2_flush_rotation_send_scroll(u8x8, fr);
+  u8g2_flush_rotation_update_ram(fr);
+  
+  y = 0;
+  while( y < fr->panel_info->tile_height )
+  {
+    if ( fr->dirty_x1[y] == 0 )
+    {
+      y++;
+      continue;
+    }
+    rows = 1;
+    while( y + rows < fr->panel_info->tile_height && fr->dirty_x1[y+rows] == fr->dirty_x1[y] && fr->dirty_x0[y+rows] == fr->dirty_x0[y] )
+      rows++;
+    tile.x_pos = fr->dirty_x0[y];
+    tile.y_pos = y;
+    tile.cnt = fr->dirty_x1[y] - fr->dirty_x0[y];
+    tile.tile_ptr = fr->ram + ((uint16_t)y * fr->panel_info->tile_width + tile.x_pos) * 8;
+    if ( rows == 1 || u8g2_flush_rotation_forward(u8x8, fr, U8X8_MSG_DISPLAY_DRAW_TILE_AREA, rows, (void *)&tile) == 0 )
+    {
+      /* the display does not support areas: send row by row */
+      for( ; rows > 0; rows-- )
+      {
+	tile.x_pos = fr->dirty_x0[y];
+	tile.y_pos = y;
+	tile.cnt = fr->dirty_x1[y] - fr->dirty_x0[y];
+	tile.tile_ptr = fr->ram + ((uint16_t)y * fr->panel_info->tile_width + tile.x_pos) * 8;
+	u8g2_flush_rotation_forward(u8x8, fr, U8X8_MSG_DISPLAY_DRAW_TILE, 1, (void *)&tile);
+	fr->dirty_x1[y] = 0;
+	y++;
+      }
+    }
+    else
+    {
+      for( ; rows > 0; rows-- )
+	fr->dirty_x1[y++] = 0;
+    }
+  }
+}
+
+/* replaces the display procedure of the controller */
+static uint8_t u8g2_flush_rotation_display_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  /* u8x8 is the first member of u8g2 */
+  u8g2_flush_rotation_t *fr = ((u8g2_t *)u8x8)->flush_rotation;
+  u8x8_tile_t *tile;
+  uint8_t *ptr;
+  uint8_t x, y, i;
+  
+  switch(msg)
+  {
+    case U8X8_MSG_DISPLAY_DRAW_TILE_AREA:
+      tile = (u8x8_tile_t *)arg_ptr;
+      ptr = tile->tile_ptr;
+      for( y = tile->y_pos; arg_int > 0 && y < fr->display_info.tile_height; y++, arg_int-- )
+      {
+	for( i = 0, x = tile->x_pos; i < tile->cnt && x < fr->display_info.tile_width; i++, x++ )
+	  u8g2_flush_rotation_store_tile(fr, x, y, ptr + i*8);
+	ptr += fr->display_info.tile_width * 8;
+      }
+      if ( y == fr->display_info.tile_height )
+	u8g2_flush_rotation_send(u8x8, fr);
+      return 1;
+    case U8X8_MSG_DISPLAY_DRAW_TILE:
+      tile = (u8x8_tile_t *)arg_ptr;
+      if ( tile->y_pos >= fr->display_info.tile_height )
+	return 1;
+      /* the tiles are repeated arg_int times, see u8x8_ClearDisplayWithTile() */
+      x = tile->x_pos;
+      do
+      {
+	for( i = 0; i < tile->cnt && x < fr->display_info.tile_width; i++, x++ )
+	  u8g2_flush_rotation_store_tile(fr, x, tile->y_pos, tile->tile_ptr + i*8);
+	arg_int--;
+      } while( arg_int > 0 );
+      /* the buffer is sent from top to bottom: all changes are known after the last tile row */
+      if ( tile->y_pos + 1 == fr->display_info.tile_height )
+	u8g2_flush_rotation_send(u8x8, fr);
+      return 1;
+    case U8X8_MSG_DISPLAY_REFRESH:
+      u8g2_flush_rotation_send(u8x8, fr);
+      break;
+    case U8X8_MSG_DISPLAY_INIT:
+      fr->is_ram_valid = 0;
+      fr->scroll_x = 0;
+      fr->pending_scroll_x = 0;
+      break;
+  }
+  return u8g2_flush_rotation_forward(u8x8, fr, msg, arg_int, arg_ptr);
+}
+
+uint8_t u8g2_SetupFlushRotation(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb, u8g2_flush_rotation_t *fr, uint8_t *shadow)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  const u8x8_display_info_t *info = u8x8->display_info;
+  uint16_t size;
+  
+  if ( u8g2_cb != U8G2_R0 && u8g2_cb != U8G2_R1 && u8g2_cb != U8G2_R3 )
+    return 0;
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+    return 0;
+  if ( u8g2->tile_buf_height != info->tile_height )
+    return 0;	/* not in full buffer mode */
+  if ( info->tile_height > U8G2_FLUSH_ROTATION_MAX_TILE_ROWS )
+    return 0;
+  
+  fr->display_info = *info;
+  fr->rotation = 0;
+  if ( u8g2_cb != U8G2_R0 )
+  {
+    fr->display_info.tile_width = info->tile_height;
+    fr->display_info.tile_height = info->tile_width;
+    fr->display_info.pixel_width = info->pixel_height;
+    fr->display_info.pixel_height = info->pixel_width;
+    fr->rotation = 1;
+    if ( u8g2_cb == U8G2_R3 )
+      fr->rotation = 3;
+  }
+  fr->panel_info = info;
+  fr->display_cb = u8x8->display_cb;
+  
+  /* the content of the display is unknown: the first flush sends everything */
+  size = info->tile_width;
+  size *= info->tile_height;
+  size *= 8;
+  fr->image = shadow;
+  fr->ram = shadow + size;
+  memset(fr->image, 0, size);
+  memset(fr->dirty_x1, 0, sizeof(fr->dirty_x1));
+  fr->is_ram_valid = 0;
+  fr->scroll_x = 0;
+  fr->pending_scroll_x = 0;
+  fr->start_line = u8x8->display_start_line;
+  
+  u8x8->display_info = &fr->display_info;
+  u8x8->display_cb = u8g2_flush_rotation_display_cb;
+  u8g2->flush_rotation = fr;
+  u8g2->tile_buf_height = fr->display_info.tile_height;
+  u8g2_SetDisplayRotation(u8g2, U8G2_R0);
+  return 1;
+}
+
+uint8_t u8g2_ScrollFlushRotation(u8g2_t *u8g2, u8g2_int_t dx, u8g2_int_t dy)
+{
+  u8g2_flush_rotation_t *fr = u8g2->flush_rotation;
+  int16_t d;
+  
+  if ( fr == NULL )
+    return 0;
+  /* movement along the horizontal axis of the controller */
+  if ( fr->rotation == 0 && dx != 0 )
+  {
+    if ( dy != 0 )
+      return 0;
+    if ( u8g2_flush_rotation_forward(u8g2_GetU8x8(u8g2), fr, U8X8_MSG_DISPLAY_SCROLL_COLUMN, U8X8_SCROLL_COLUMN_CHECK, NULL) == 0 )
+      return 0;
+    d = fr->scroll_x + dx;
+    if ( d > 127 )
+      d = 127;
+    if ( d < -127 )
+      d = -127;
+    fr->scroll_x = d;
+    return 1;
+  }
+  /* the start line wraps around at the 64 lines of the controller RAM */
+  if ( fr->panel_info->tile_height != 8 )
+    return 0;
+  /* movement along the vertical axis of the controller */
+  if ( fr->rotation == 0 )
+  {
+    d = dy;
+  }
+  else
+  {
+    if ( dy != 0 )
+      return 0;
+    d = dx;
+    if ( fr->rotation == 3 )
+      d = -d;
+  }
+  /* if the content moves up, the display has to show lines further down in the RAM */
+  d = (int16_t)fr->start_line - d;
+  d %= 64;
+  if ( d < 0 )
+    d += 64;
+  fr->start_line = d;
+  return 1;
+}
+
+/*============================================*/
+/* 4bpp gray image */
+
+/* change the pixels of mask in *ptr, value has the level in both nibbles */
+static void u8g2_gray_set(uint8_t *ptr, uint8_t mask, uint8_t value, uint8_t color)
+{
+  if ( color == 2 )
+    *ptr ^= value & mask;
+  else if ( color == 1 )
+    *ptr = (*ptr & ~mask) | (value & mask);
+  else
+    *ptr &= ~mask;
+}
+
+/*
+  x,y		Upper left position of the box within the image
+  w,h		width and height of the box in pixel, both must not be 0
+  asumption: 
+    all clipping done
+*/
+static void u8g2_ll_box_gray(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  uint16_t stride = (uint16_t)u8g2_GetU8x8(u8g2)->display_info->tile_width * 4;
+  uint8_t color = u8g2->draw_color;
+  uint8_t value = u8g2->gray->level * 0x011;
+  uint8_t *row = u8g2->gray->image + (uint16_t)y * stride + (x >> 1);
+  uint8_t *ptr;
+  u8g2_uint_t cnt, i;
+  
+  do
+  {
+    ptr = row;
+    cnt = w;
+    /* a box starting at an odd x begins with the lower nibble */
+    if ( x & 1 )
+    {
+      u8g2_gray_set(ptr, 0x00f, value, color);
+      ptr++;
+      cnt--;
+    }
+    if ( color <= 1 )
+    {
+      memset(ptr, color == 0 ? 0 : value, cnt >> 1);
+    }
+    else
+    {
+      for( i = 0; i < (cnt >> 1); i++ )
+	ptr[i] ^= value;
+    }
+    if ( cnt & 1 )
+      u8g2_gray_set(ptr + (cnt >> 1), 0x0f0, value, color);
+    row += stride;
+    h--;
+  } while( h != 0 );
+}
+
+static void u8g2_ll_hvline_gray(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  if ( dir == 0 )
+    u8g2_ll_box_gray(u8g2, x, y, len, 1);
+  else
+    u8g2_ll_box_gray(u8g2, x, y, 1, len);
+}
+
+/* 
+  row y of the image with the set pixels of the 1bpp buffer over it, in 
+  gray->row. The image itself is not changed
+*/
+static const uint8_t *u8g2_gray_compose_row(u8g2_t *u8g2, uint16_t y)
+{
+  u8g2_gray_t *gray = u8g2->gray;
+  uint16_t stride = (uint16_t)u8g2_GetU8x8(u8g2)->display_info->tile_width * 4;
+  const uint8_t *src = u8g2->tile_buf_ptr + (y >> 3) * (uint16_t)u8g2->pixel_buf_width;
+  uint8_t mask = 1 << (y & 7);
+  uint8_t value = gray->mono_level * 0x011;
+  uint8_t *dest = gray->row;
+  uint16_t x;
+  
+  memcpy(dest, gray->image + y * stride, stride);
+  for( x = 0; x < stride; x++, src += 2 )
+  {
+    /* the left pixel of a pair is the upper nibble */
+    if ( src[0] & mask )
+      dest[x] = (dest[x] & 0x00f) | (value & 0x0f0);
+    if ( src[1] & mask )
+      dest[x] = (dest[x] & 0x0f0) | (value & 0x00f);
+  }
+  return dest;
+}
+
+/* send one rectangle of the image and remember it as the RAM content */
+static void u8g2_gray_send_area(u8g2_t *u8g2, uint8_t x0, uint8_t x1, uint8_t y0, uint8_t y1)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  u8g2_gray_t *gray = u8g2->gray;
+  uint16_t stride = (uint16_t)u8x8->display_info->tile_width * 4;
+  u8x8_gray_area_t area;
+  uint16_t offset;
+  uint8_t y;
+  
+  for( y = y0; y < y1; y++ )
+  {
+    offset = (uint16_t)y * stride + x0;
+    memcpy(gray->ram + offset, u8g2_gray_compose_row(u8g2, y) + x0, x1 - x0);
+  }
+  area.ptr = gray->ram + (uint16_t)y0 * stride + x0;
+  area.stride = stride;
+  area.cnt = x1 - x0;
+  area.x_pos = x0;
+  area.y_pos = y0;
+  gray->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_GRAY_AREA, y1 - y0, (void *)&area);
+}
+
+/* 
+  the bounding rectangle of the changed bytes of tile row "row" (8 pixel 
+  rows), returns 0 if nothing has changed 
+*/
+static uint8_t u8g2_gray_changed_area(u8g2_t *u8g2, uint8_t row, uint16_t *x0, uint16_t *x1, uint16_t *y0, uint16_t *y1)
+{
+  u8g2_gray_t *gray = u8g2->gray;
+  uint16_t stride = (uint16_t)u8g2_GetU8x8(u8g2)->display_info->tile_width * 4;
+  uint16_t y = (uint16_t)row * 8;
+  uint16_t y_end = y + 8;
+  const uint8_t *image;
+  const uint8_t *ram;
+  uint16_t x;
+  
+  *x0 = stride;
+  *x1 = 0;
+  *y0 = y_end;
+  *y1 = y;
+  for( ; y < y_end; y++ )
+  {
+    image = u8g2_gray_compose_row(u8g2, y);
+    ram = gray->ram + y * stride;
+    if ( gray->is_ram_valid != 0 && memcmp(image, ram, stride) == 0 )
+      continue;
+    if ( *y0 == y_end )
+      *y0 = y;
+    *y1 = y + 1;
+    if ( gray->is_ram_valid == 0 )
+    {
+      *x0 = 0;
+      *x1 = stride;
+      continue;
+    }
+    for( x = 0; x < *x0 && image[x] == ram[x]; x++ )
+      ;
+    *x0 = x;
+    for( x = stride; x > *x1 && image[x-1] == ram[x-1]; x-- )
+      ;
+    *x1 = x;
+  }
+  return *y1 > *y0;
+}
+
+/* 
+  find the changed bytes of each tile row (8 pixel rows) and send their 
+  bounding rectangle. Rectangles of adjacent tile rows with the same columns
+  are sent together.
+*/
+void u8g2_SendGray(u8g2_t *u8g2)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  u8g2_gray_t *gray = u8g2->gray;
+  uint8_t row;
+  uint16_t y0, y1;
+  uint16_t x0, x1;
+  uint16_t area_x0 = 0, area_x1 = 0, area_y0 = 0, area_y1 = 0;
+  
+  if ( gray == NULL )
+    return;
+  for( row = 0; row < u8x8->display_info->tile_height; row++ )
+  {
+    if ( u8g2_gray_changed_area(u8g2, row, &x0, &x1, &y0, &y1) == 0 )
+      continue;
+    if ( area_y1 == y0 && area_x0 == x0 && area_x1 == x1 )
+    {
+      area_y1 = y1;
+      continue;
+    }
+    if ( area_y1 > area_y0 )
+      u8g2_gray_send_area(u8g2, area_x0, area_x1, area_y0, area_y1);
+    area_x0 = x0;
+    area_x1 = x1;
+    area_y0 = y0;
+    area_y1 = y1;
+  }
+  if ( area_y1 > area_y0 )
+    u8g2_gray_send_area(u8g2, area_x0, area_x1, area_y0, area_y1);
+  gray->is_ram_valid = 1;
+}
+
+/* replaces the display procedure of the controller */
+static uint8_t u8g2_gray_display_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  /* u8x8 is the first member of u8g2 */
+  u8g2_gray_t *gray = ((u8g2_t *)u8x8)->gray;
+  uint8_t tile_height = u8x8->display_info->tile_height;
+  u8x8_tile_t *tile;
+  
+  switch(msg)
+  {
+    /* 
+      the tiles are those of the 1bpp buffer, which is read as a whole when 
+      the image is sent. The buffer is sent from top to bottom: all changes 
+      are known after the last tile row 
+    */
+    case U8X8_MSG_DISPLAY_DRAW_TILE_AREA:
+      tile = (u8x8_tile_t *)arg_ptr;
+      if ( tile->y_pos + arg_int >= tile_height )
+	u8g2_SendGray((u8g2_t *)u8x8);
+      return 1;
+    case U8X8_MSG_DISPLAY_DRAW_TILE:
+      tile = (u8x8_tile_t *)arg_ptr;
+      if ( tile->y_pos + 1 == tile_height )
+	u8g2_SendGray((u8g2_t *)u8x8);
+      return 1;
+    case U8X8_MSG_DISPLAY_INIT:
+      gray->is_ram_valid = 0;
+      break;
+  }
+  return gray->display_cb(u8x8, msg, arg_int, arg_ptr);
+}
+
+uint8_t u8g2_SetupGray(u8g2_t *u8g2, u8g2_gray_t *gray, uint8_t *shadow)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  const u8x8_display_info_t *info = u8x8->display_info;
+  uint16_t size;
+  
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+    return 0;
+  if ( u8g2->tile_buf_height != info->tile_height )
+    return 0;	/* not in full buffer mode */
+  if ( u8g2->flush_rotation != NULL )
+    return 0;
+  if ( info->tile_width > U8G2_GRAY_MAX_TILE_WIDTH )
+    return 0;
+  
+  gray->display_cb = u8x8->display_cb;
+  gray->mono_hvline = u8g2->ll_hvline;
+  gray->mono_box = u8g2->ll_box;
+  gray->level = 15;
+  gray->mono_level = 15;
+  
+  /* the content of the display is unknown: the first send writes everything */
+  size = info->tile_width;
+  size *= info->tile_height;
+  size *= 32;
+  gray->image = shadow;
+  gray->ram = shadow + size;
+  memset(gray->image, 0, size);
+  gray->is_ram_valid = 0;
+  
+  u8x8->display_cb = u8g2_gray_display_cb;
+  u8g2->gray = gray;
+  return 1;
+}
+
+void u8g2_SetGrayLevel(u8g2_t *u8g2, uint8_t level)
+{
+  u8g2_gray_t *gray = u8g2->gray;
+  
+  if ( gray == NULL )
+    return;
+  if ( level == U8G2_GRAY_MONO )
+  {
+    u8g2->ll_hvline = gray->mono_hvline;
+    u8g2->ll_box = gray->mono_box;
+    return;
+  }
+  gray->level = level & 15;
+  u8g2->ll_hvline = u8g2_ll_hvline_gray;
+  u8g2->ll_box = u8g2_ll_box_gray;
+}
+
+void u8g2_SetMonoGrayLevel(u8g2_t *u8g2, uint8_t level)
+{
+  if ( u8g2->gray != NULL )
+    u8g2->gray->mono_level = level & 15;
+}
+
+/*============================================*/
+/* send the buffer one page at a time */
+
+/* the tiles of the buffer, as they are passed to the rotate at flush display procedure by u8g2_SendBuffer() */
+static void u8g2_store_buffer_tiles(u8g2_t *u8g2)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  uint8_t tw = u8x8->display_info->tile_width;
+  uint8_t th = u8x8->display_info->tile_height;
+  uint8_t *ptr = u8g2->tile_buf_ptr;
+  uint8_t x, y;
+  
+  for( y = 0; y < th; y++ )
+  {
+    for( x = 0; x < tw; x++, ptr += 8 )
+      u8g2_flush_rotation_store_tile(u8g2->flush_rotation, x, y, ptr);
+  }
+}
+
+uint8_t u8g2_PrepareSendPages(u8g2_t *u8g2)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  u8g2_gray_t *gray = u8g2->gray;
+  uint16_t stride, y, x;
+  const uint8_t *row;
+  
+  if ( u8g2->tile_buf_height != u8x8->display_info->tile_height )
+    return 0;	/* not in full buffer mode */
+  if ( u8g2->flush_rotation != NULL )
+  {
+    u8g2_store_buffer_tiles(u8g2);
+    u8g2_flush_rotation_move_ram(u8g2->flush_rotation);
+    u8g2_flush_rotation_update_ram(u8g2->flush_rotation);
+    return u8g2->flush_rotation->panel_info->tile_height;
+  }
+  if ( gray != NULL )
+  {
+    if ( gray->is_ram_valid == 0 )
+    {
+      /* the pages are compared one at a time: make all of them differ */
+      stride = (uint16_t)u8x8->display_info->tile_width * 4;
+      for( y = 0; y < u8x8->display_info->pixel_height; y++ )
+      {
+	row = u8g2_gray_compose_row(u8g2, y);
+	for( x = 0; x < stride; x++ )
+	  gray->ram[y * stride + x] = ~row[x];
+      }
+      gray->is_ram_valid = 1;
+    }
+  }
+  return u8x8->display_info->tile_height;
+}
+
+uint16_t u8g2_GetPageBytes(u8g2_t *u8g2, uint8_t page)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  u8g2_flush_rotation_t *fr = u8g2->flush_rotation;
+  uint16_t x0, x1, y0, y1;
+  
+  if ( fr != NULL )
+    return (uint16_t)(fr->dirty_x1[page] - fr->dirty_x0[page]) * 8;
+  if ( u8g2->gray != NULL )
+  {
+    if ( u8g2_gray_changed_area(u8g2, page, &x0, &x1, &y0, &y1) == 0 )
+      return 0;
+    return (x1 - x0) * (y1 - y0);
+  }
+  return (uint16_t)u8x8->display_info->tile_width * 8;
+}
+
+uint16_t u8g2_SendPage(u8g2_t *u8g2, uint8_t page)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  u8g2_flush_rotation_t *fr = u8g2->flush_rotation;
+  u8x8_tile_t tile;
+  uint16_t x0, x1, y0, y1;
+  
+  if ( fr != NULL )
+  {
+    u8g2_flush_rotation_send_scroll(u8x8, fr);
+    if ( fr->start_line != u8x8->display_start_line )
+    {
+      if ( u8g2_flush_rotation_forward(u8x8, fr, U8X8_MSG_DISPLAY_SET_START_LINE, fr->start_line, NULL) == 0 )
+      {
+	/* not supported by the controller: send everything again without it */
+	fr->start_line = u8x8->display_start_line;
+	fr->is_ram_valid = 0;
+	u8g2_flush_rotation_update_ram(fr);
+      }
+    }
+    if ( fr->dirty_x1[page] == 0 )
+      return 0;
+    tile.x_pos = fr->dirty_x0[page];
+    tile.y_pos = page;
+    tile.cnt = fr->dirty_x1[page] - fr->dirty_x0[page];
+    tile.tile_ptr = fr->ram + ((uint16_t)page * fr->panel_info->tile_width + tile.x_pos) * 8;
+    u8g2_flush_rotation_forward(u8x8, fr, U8X8_MSG_DISPLAY_DRAW_TILE, 1, (void *)&tile);
+    fr->dirty_x1[page] = 0;
+    return (uint16_t)tile.cnt * 8;
+  }
+  if ( u8g2->gray != NULL )
+  {
+    if ( u8g2_gray_changed_area(u8g2, page, &x0, &x1, &y0, &y1) == 0 )
+      return 0;
+    u8g2_gray_send_area(u8g2, x0, x1, y0, y1);
+    return (x1 - x0) * (y1 - y0);
+  }
+  u8x8_DrawTile(u8x8, 0, page, u8x8->display_info->tile_width, u8g2->tile_buf_ptr + (uint16_t)page * u8g2->pixel_buf_width);
+  return (uint16_t)u8x8->display_info->tile_width * 8;
+}
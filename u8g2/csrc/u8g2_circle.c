@@ -35,6 +35,318 @@
 
 #include "u8g2.h"
 
+/*==============================================*/
+/* Span tables */
+
+/*
+  The span tables are calculated with the same midpoint algorithms as the
+  pixel based procedures below, but instead of drawing a pixel, only the 
+  widest x of each row is stored. Rows which did not get a pixel of their 
+  own (steep part of a narrow ellipse) get the width of the row below, so 
+  that outlines drawn from the table have no gaps.
+*/
+
+static void u8g2_update_span(u8g2_uint_t *spans, u8g2_uint_t ry, u8g2_uint_t x, u8g2_uint_t y)
+{
+  if ( y <= ry )
+    if ( spans[y] < x )
+      spans[y] = x;
+}
+
+static void u8g2_init_spans(u8g2_uint_t *spans, u8g2_uint_t ry)
+{
+  u8g2_uint_t y = 0;
+  for(;;)
+  {
+    spans[y] = 0;
+    if ( y == ry )
+      break;
+    y++;
+  }
+}
+
+static void u8g2_finish_spans(u8g2_uint_t *spans, u8g2_uint_t ry)
+{
+  /* a row is at least as wide as all rows below */
+  u8g2_uint_t y = ry;
+  while( y > 0 )
+  {
+    y--;
+    if ( spans[y] < spans[y+1] )
+      spans[y] = spans[y+1];
+  }
+}
+
+void u8g2_CalculateCircleSpans(u8g2_uint_t *spans, u8g2_uint_t rad)
+{
+  u8g2_int_t f;
+  u8g2_int_t ddF_x;
+  u8g2_int_t ddF_y;
+  u8g2_uint_t x;
+  u8g2_uint_t y;
+
+  u8g2_init_spans(spans, rad);
+  
+  f = 1;
+  f -= rad;
+  ddF_x = 1;
+  ddF_y = 0;
+  ddF_y -= rad;
+  ddF_y *= 2;
+  x = 0;
+  y = rad;
+
+  u8g2_update_span(spans, rad, x, y);
+  u8g2_update_span(spans, rad, y, x);
+  
+  while ( x < y )
+  {
+    if (f >= 0) 
+    {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+
+    u8g2_update_span(spans, rad, x, y);
+    u8g2_update_span(spans, rad, y, x);
+  }
+  
+  u8g2_finish_spans(spans, rad);
+}
+
+void u8g2_CalculateEllipseSpans(u8g2_uint_t *spans, u8g2_uint_t rx, u8g2_uint_t ry)
+{
+  u8g2_uint_t x, y;
+  u8g2_long_t xchg, ychg;
+  u8g2_long_t err;
+  u8g2_long_t rxrx2;
+  u8g2_long_t ryry2;
+  u8g2_long_t stopx, stopy;
+  
+  u8g2_init_spans(spans, ry);
+  
+  /* the midpoint algorithm does not terminate for a single pixel */
+  if ( rx == 0 && ry == 0 )
+    return;
+  
+  rxrx2 = rx;
+  rxrx2 *= rx;
+  rxrx2 *= 2;
+  
+  ryry2 = ry;
+  ryry2 *= ry;
+  ryry2 *= 2;
+  
+  x = rx;
+  y = 0;
+  
+  xchg = 1;
+  xchg -= rx;
+  xchg -= rx;
+  xchg *= ry;
+  xchg *= ry;
+  
+  ychg = rx;
+  ychg *= rx;
+  
+  err = 0;
+  
+  stopx = ryry2;
+  stopx *= rx;
+  stopy = 0;
+  
+  while( stopx >= stopy )
+  {
+    u8g2_update_span(spans, ry, x, y);
+    y++;
+    stopy += rxrx2;
+    err += ychg;
+    ychg += rxrx2;
+    if ( 2*err+xchg > 0 )
+    {
+      x--;
+      stopx -= ryry2;
+      err += xchg;
+      xchg += ryry2;      
+    }
+  }
+
+  x = 0;
+  y = ry;
+  
+  xchg = ry;
+  xchg *= ry;
+  
+  ychg = 1;
+  ychg -= ry;
+  ychg -= ry;
+  ychg *= rx;
+  ychg *= rx;
+  
+  err = 0;
+  
+  stopx = 0;
+
+  stopy = rxrx2;
+  stopy *= ry;
+
+  while( stopx <= stopy )
+  {
+    u8g2_update_span(spans, ry, x, y);
+    x++;
+    stopx += ryry2;
+    err += xchg;
+    xchg += ryry2;
+    if ( 2*err+ychg > 0 )
+    {
+      y--;
+      stopy -= rxrx2;
+      err += ychg;
+      ychg += rxrx2;
+    }
+  }
+  
+  u8g2_finish_spans(spans, ry);
+}
+
+/* the number of pixel positions: positions wrap around like those of u8g2_DrawPixel() */
+#ifdef U8G2_16BIT
+#define U8G2_SPAN_WRAP 0x10000L
+#else
+#define U8G2_SPAN_WRAP 0x100
+#endif
+
+/* draw the pixel x0..x1 (both included, x0 >= 0, x1 < U8G2_SPAN_WRAP) of row y, y must be inside the user window */
+static void u8g2_draw_span_clipped(u8g2_t *u8g2, u8g2_long_t x0, u8g2_long_t x1, u8g2_uint_t y)
+{
+  if ( x0 < (u8g2_long_t)u8g2->user_x0 )
+    x0 = u8g2->user_x0;
+  if ( x1 >= (u8g2_long_t)u8g2->user_x1 )
+    x1 = (u8g2_long_t)u8g2->user_x1 - 1;
+  if ( x0 > x1 )
+    return;
+  u8g2->cb->draw_l90(u8g2, (u8g2_uint_t)x0, y, (u8g2_uint_t)(x1-x0+1), 0);
+}
+
+/* draw the pixel x0..x1 (both included) of row y, with x0 and x1 wrapped around */
+static void u8g2_draw_span(u8g2_t *u8g2, u8g2_long_t x0, u8g2_long_t x1, u8g2_uint_t y)
+{
+  if ( x0 < 0 )
+  {
+    x0 += U8G2_SPAN_WRAP;
+    x1 += U8G2_SPAN_WRAP;
+  }
+  else if ( x0 >= U8G2_SPAN_WRAP )
+  {
+    x0 -= U8G2_SPAN_WRAP;
+    x1 -= U8G2_SPAN_WRAP;
+  }
+  if ( x1 >= U8G2_SPAN_WRAP )
+  {
+    /* the end of the span continues at position 0 */
+    u8g2_draw_span_clipped(u8g2, x0, U8G2_SPAN_WRAP-1, y);
+    x1 -= U8G2_SPAN_WRAP;
+    if ( x1 >= x0 )
+      x1 = x0-1;
+    x0 = 0;
+  }
+  u8g2_draw_span_clipped(u8g2, x0, x1, y);
+}
+
+/*
+  Draw an outline or filled shape from a span table.
+  Positions wrap around like those of u8g2_DrawPixel(), so shapes with a 
+  centre at a "negative" position are drawn as well. Each visible row 
+  is passed as one or two horizontal lines to the display rotation 
+  procedure. Every pixel is drawn only once, so XOR mode works as expected.
+*/
+void u8g2_DrawSpans(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, const u8g2_uint_t *spans, u8g2_uint_t ry, uint8_t option, uint8_t is_filled)
+{
+  u8g2_long_t y, dy, dy_end, d;
+  u8g2_long_t lo, hi;
+  uint8_t upper, lower, sides;
+  
+  /* bit 0: left half, bit 1: right half */
+  upper = 0;
+  if ( option & U8G2_DRAW_UPPER_LEFT )
+    upper |= 1;
+  if ( option & U8G2_DRAW_UPPER_RIGHT )
+    upper |= 2;
+  lower = 0;
+  if ( option & U8G2_DRAW_LOWER_LEFT )
+    lower |= 1;
+  if ( option & U8G2_DRAW_LOWER_RIGHT )
+    lower |= 2;
+  
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+  dy = 0;
+  if ( upper != 0 )
+    dy -= ry;
+  dy_end = 0;
+  if ( lower != 0 )
+    dy_end += ry;
+  
+  for( ; dy <= dy_end; dy++ )
+  {
+    /* clip against the user window */
+    y = y0;
+    y += dy;
+    if ( y < 0 )
+      y += U8G2_SPAN_WRAP;
+    else if ( y >= U8G2_SPAN_WRAP )
+      y -= U8G2_SPAN_WRAP;
+    if ( y < (u8g2_long_t)u8g2->user_y0 || y >= (u8g2_long_t)u8g2->user_y1 )
+      continue;
+    d = dy;
+    if ( d < 0 )
+    {
+      d = -d;
+      sides = upper;
+    }
+    else if ( d > 0 )
+    {
+      sides = lower;
+    }
+    else
+    {
+      sides = upper | lower;
+    }
+    if ( sides == 0 )
+      continue;
+    
+    hi = spans[d];
+    lo = 0;
+    if ( is_filled == 0 && d < ry )
+    {
+      /* outline: start right after the next row towards the top or bottom */
+      lo = spans[d+1];
+      lo++;
+      if ( lo > hi )
+	lo = hi;
+    }
+    
+    if ( sides == 3 && lo == 0 )
+    {
+      u8g2_draw_span(u8g2, (u8g2_long_t)x0-hi, (u8g2_long_t)x0+hi, y);
+    }
+    else
+    {
+      if ( sides & 1 )
+	u8g2_draw_span(u8g2, (u8g2_long_t)x0-hi, (u8g2_long_t)x0-lo, y);
+      if ( sides & 2 )
+	u8g2_draw_span(u8g2, (u8g2_long_t)x0+lo, (u8g2_long_t)x0+hi, y);
+    }
+  }
+}
+
 /*==============================================*/
 /* Circle */
 
@@ -108,6 +420,8 @@ static void u8g2_draw_circle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_
 
 void u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
 {
+  u8g2_uint_t spans[U8G2_MAX_SPAN_RADIUS+1];
+
   /* check for bounding box */
 #ifdef U8G2_WITH_INTERSECTION
   {
@@ -118,6 +432,13 @@ void u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t r
   
   
   /* draw circle */
+  if ( rad <= U8G2_MAX_SPAN_RADIUS )
+  {
+    u8g2_CalculateCircleSpans(spans, rad);
+    u8g2_DrawSpans(u8g2, x0, y0, spans, rad, option, 0);
+    return;
+  }
+  
   u8g2_draw_circle(u8g2, x0, y0, rad, option);
 }
 
@@ -194,6 +515,8 @@ static void u8g2_draw_disc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_ui
 
 void u8g2_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
 {
+  u8g2_uint_t spans[U8G2_MAX_SPAN_RADIUS+1];
+
   /* check for bounding box */
 #ifdef U8G2_WITH_INTERSECTION
   {
@@ -203,6 +526,13 @@ void u8g2_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad
 #endif /* U8G2_WITH_INTERSECTION */
   
   /* draw disc */
+  if ( rad <= U8G2_MAX_SPAN_RADIUS )
+  {
+    u8g2_CalculateCircleSpans(spans, rad);
+    u8g2_DrawSpans(u8g2, x0, y0, spans, rad, option, 1);
+    return;
+  }
+  
   u8g2_draw_disc(u8g2, x0, y0, rad, option);
 }
 
@@ -332,6 +662,8 @@ static void u8g2_draw_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2
 
 void u8g2_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
 {
+  u8g2_uint_t spans[U8G2_MAX_SPAN_RADIUS+1];
+
   /* check for bounding box */
 #ifdef U8G2_WITH_INTERSECTION
   {
@@ -340,6 +672,13 @@ void u8g2_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t
   }
 #endif /* U8G2_WITH_INTERSECTION */
   
+  if ( ry <= U8G2_MAX_SPAN_RADIUS )
+  {
+    u8g2_CalculateEllipseSpans(spans, rx, ry);
+    u8g2_DrawSpans(u8g2, x0, y0, spans, ry, option, 0);
+    return;
+  }
+  
   u8g2_draw_ellipse(u8g2, x0, y0, rx, ry, option);
 }
 
@@ -465,6 +804,8 @@ static void u8g2_draw_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y
 
 void u8g2_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
 {
+  u8g2_uint_t spans[U8G2_MAX_SPAN_RADIUS+1];
+
   /* check for bounding box */
 #ifdef U8G2_WITH_INTERSECTION
   {
@@ -473,6 +814,13 @@ void u8g2_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_u
   }
 #endif /* U8G2_WITH_INTERSECTION */
   
+  if ( ry <= U8G2_MAX_SPAN_RADIUS )
+  {
+    u8g2_CalculateEllipseSpans(spans, rx, ry);
+    u8g2_DrawSpans(u8g2, x0, y0, spans, ry, option, 1);
+    return;
+  }
+  
   u8g2_draw_filled_ellipse(u8g2, x0, y0, rx, ry, option);
 }
 
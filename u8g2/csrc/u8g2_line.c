@@ -90,3 +90,272 @@ void u8g2_DrawLine(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2,
   }
 }
 
+
+/*==============================================*/
+/* Pixel lists and polylines */
+
+/*
+  The user window is fetched once for all pixels of a call. If the
+  display is not rotated and uses a vertical_top_lsb buffer (SSD13xx,
+  SH1106), the bits are set directly in the tile buffer. Otherwise each
+  pixel is passed to the rotation procedure.
+*/
+typedef struct
+{
+  u8g2_t *u8g2;
+  int32_t x0, y0, x1, y1;	/* user window, x1 and y1 are excluded */
+  uint8_t *buf;		/* NULL if pixels can not be set directly */
+  uint16_t stride;
+  int32_t row;		/* pixel_curr_row */
+  uint8_t or_mask;
+  uint8_t xor_mask;
+} u8g2_pixel_batch_t;
+
+static void u8g2_init_pixel_batch(u8g2_t *u8g2, u8g2_pixel_batch_t *b)
+{
+  b->u8g2 = u8g2;
+  b->x0 = u8g2->user_x0;
+  b->y0 = u8g2->user_y0;
+  b->x1 = u8g2->user_x1;
+  b->y1 = u8g2->user_y1;
+  b->buf = NULL;
+  if ( u8g2->cb == U8G2_R0 && u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+  {
+    b->buf = u8g2->tile_buf_ptr;
+    b->stride = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+    b->stride *= 8;
+    b->row = u8g2->pixel_curr_row;
+    b->or_mask = 0;
+    b->xor_mask = 0;
+    if ( u8g2->draw_color <= 1 )
+      b->or_mask = 0x0ff;
+    if ( u8g2->draw_color != 1 )
+      b->xor_mask = 0x0ff;
+  }
+}
+
+static uint8_t u8g2_is_batch_pixel_visible(const u8g2_pixel_batch_t *b, int32_t x, int32_t y)
+{
+  if ( x < b->x0 || x >= b->x1 )
+    return 0;
+  if ( y < b->y0 || y >= b->y1 )
+    return 0;
+  return 1;
+}
+
+/* x,y must be inside the user window */
+static void u8g2_draw_batch_pixel(const u8g2_pixel_batch_t *b, int32_t x, int32_t y)
+{
+  uint8_t *ptr;
+  uint8_t mask;
+  
+  if ( b->buf == NULL )
+  {
+    b->u8g2->cb->draw_l90(b->u8g2, (u8g2_uint_t)x, (u8g2_uint_t)y, 1, 0);
+    return;
+  }
+  
+  y -= b->row;
+  ptr = b->buf;
+  ptr += (y >> 3) * b->stride;
+  ptr += x;
+  mask = 1;
+  mask <<= y & 7;
+  *ptr |= b->or_mask & mask;
+  *ptr ^= b->xor_mask & mask;
+}
+
+void u8g2_DrawPixels(u8g2_t *u8g2, const u8g2_xy_t *points, uint16_t cnt)
+{
+  u8g2_pixel_batch_t b;
+  
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+  u8g2_init_pixel_batch(u8g2, &b);
+  while( cnt > 0 )
+  {
+    if ( u8g2_is_batch_pixel_visible(&b, points->x, points->y) )
+      u8g2_draw_batch_pixel(&b, points->x, points->y);
+    points++;
+    cnt--;
+  }
+}
+
+/*
+  Draw a horizontal (dir = 0) or vertical (dir = 1) run of pixels, 
+  x, y and len must be clipped already and len must not be 0.
+*/
+static void u8g2_draw_batch_run(const u8g2_pixel_batch_t *b, int32_t x, int32_t y, int32_t len, uint8_t dir)
+{
+  uint8_t *ptr;
+  uint8_t bit_pos, cnt, mask;
+  
+  if ( b->buf == NULL )
+  {
+    b->u8g2->cb->draw_l90(b->u8g2, (u8g2_uint_t)x, (u8g2_uint_t)y, (u8g2_uint_t)len, dir);
+    return;
+  }
+  
+  y -= b->row;
+  ptr = b->buf;
+  ptr += (y >> 3) * b->stride;
+  ptr += x;
+  bit_pos = y & 7;
+  if ( dir == 0 )
+  {
+    mask = 1;
+    mask <<= bit_pos;
+    do
+    {
+      *ptr |= b->or_mask & mask;
+      *ptr ^= b->xor_mask & mask;
+      ptr++;
+      len--;
+    } while( len != 0 );
+  }
+  else
+  {
+    do
+    {
+      /* all rows of the run within the current page */
+      cnt = 8 - bit_pos;
+      if ( len < cnt )
+	cnt = len;
+      mask = 0x0ff;
+      mask >>= 8 - cnt;
+      mask <<= bit_pos;
+      *ptr |= b->or_mask & mask;
+      *ptr ^= b->xor_mask & mask;
+      ptr += b->stride;
+      len -= cnt;
+      bit_pos = 0;
+    } while( len != 0 );
+  }
+}
+
+/*
+  Same pixels as u8g2_DrawLine(), but the line is drawn as horizontal 
+  (flat lines) or vertical (steep lines) runs. If is_skip_first is not 0, 
+  the pixel at x1,y1 is not drawn, because it is the last pixel of the 
+  previous line. 
+*/
+static void u8g2_draw_batch_line(const u8g2_pixel_batch_t *b, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint8_t is_skip_first)
+{
+  int32_t tmp;
+  int32_t x, y;
+  int32_t dx, dy;
+  int32_t err;
+  int32_t ystep;
+  int32_t run;
+  int32_t skip_x, skip_y;
+  int32_t lo, hi, lo_min, hi_max, pos, pos_min, pos_max;
+  uint8_t swapxy = 0;
+  
+  /* reject the whole line with its bounding box */
+  {
+    int32_t bx0, by0, bx1, by1;
+    if ( x1 < x2 ) { bx0 = x1; bx1 = x2; } else { bx0 = x2; bx1 = x1; }
+    if ( y1 < y2 ) { by0 = y1; by1 = y2; } else { by0 = y2; by1 = y1; }
+    if ( bx1 < b->x0 || bx0 >= b->x1 || by1 < b->y0 || by0 >= b->y1 )
+      return;
+  }
+  
+  if ( x1 > x2 ) dx = x1-x2; else dx = x2-x1;
+  if ( y1 > y2 ) dy = y1-y2; else dy = y2-y1;
+
+  /* runs go along the major axis, pos is the position on the minor axis */
+  if ( dy > dx ) 
+  {
+    swapxy = 1;
+    tmp = dx; dx =dy; dy = tmp;
+    tmp = x1; x1 =y1; y1 = tmp;
+    tmp = x2; x2 =y2; y2 = tmp;
+    lo_min = b->y0; hi_max = b->y1;
+    pos_min = b->x0; pos_max = b->x1;
+  }
+  else
+  {
+    lo_min = b->x0; hi_max = b->x1;
+    pos_min = b->y0; pos_max = b->y1;
+  }
+  skip_x = x1;
+  skip_y = y1;
+  if ( x1 > x2 ) 
+  {
+    tmp = x1; x1 =x2; x2 = tmp;
+    tmp = y1; y1 =y2; y2 = tmp;
+  }
+  err = dx >> 1;
+  if ( y2 > y1 ) ystep = 1; else ystep = -1;
+  y = y1;
+  
+  run = x1;
+  for( x = x1; ; x++ )
+  {
+    err -= dy;
+    if ( err < 0 || x == x2 )
+    {
+      /* the pixel run..x of this line ends here */
+      lo = run;
+      hi = x;
+      pos = y;
+      if ( is_skip_first != 0 && pos == skip_y )
+      {
+	if ( lo == skip_x )
+	  lo++;
+	else if ( hi == skip_x )
+	  hi--;
+      }
+      if ( lo < lo_min )
+	lo = lo_min;
+      if ( hi >= hi_max )
+	hi = hi_max - 1;
+      if ( lo <= hi && pos >= pos_min && pos < pos_max )
+      {
+	if ( swapxy == 0 )
+	  u8g2_draw_batch_run(b, lo, pos, hi-lo+1, 0);
+	else
+	  u8g2_draw_batch_run(b, pos, lo, hi-lo+1, 1);
+      }
+      if ( x == x2 )
+	break;
+      y += ystep;
+      err += dx;
+      run = x+1;
+    }
+  }
+}
+
+void u8g2_DrawPolyline(u8g2_t *u8g2, const u8g2_xy_t *points, uint16_t cnt)
+{
+  u8g2_pixel_batch_t b;
+  
+  if ( cnt == 0 )
+    return;
+  
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+
+  u8g2_init_pixel_batch(u8g2, &b);
+  if ( cnt == 1 )
+  {
+    if ( u8g2_is_batch_pixel_visible(&b, points->x, points->y) )
+      u8g2_draw_batch_pixel(&b, points->x, points->y);
+    return;
+  }
+  
+  u8g2_draw_batch_line(&b, points[0].x, points[0].y, points[1].x, points[1].y, 0);
+  points++;
+  cnt--;
+  while( cnt > 1 )
+  {
+    u8g2_draw_batch_line(&b, points[0].x, points[0].y, points[1].x, points[1].y, 1);
+    points++;
+    cnt--;
+  }
+}
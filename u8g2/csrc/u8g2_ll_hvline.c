@@ -50,6 +50,7 @@
 
 #include "u8g2.h"
 #include <assert.h>
+#include <string.h>
 
 /*=================================================*/
 /*
@@ -369,3 +370,269 @@ void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_
 }
 
 #endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
+
+/*=================================================*/
+/*
+  u8g2_ll_box_vertical_top_lsb
+  u8g2_ll_box_horizontal_right_lsb
+  
+  Filled boxes are written with one mask per byte: all rows (or columns) 
+  of the box which fall into the same byte are combined, so that each byte 
+  of the buffer is modified only once. Fully covered bytes are written with
+  memset(). The other loops are kept simple so that the compiler can 
+  vectorize them.
+*/
+
+#ifdef U8G2_WITH_HVLINE_SPEED_OPTIMIZATION
+
+/*
+  ptr		first byte of the span
+  len		number of bytes, must not be 0
+  mask		bits to modify in each byte
+  color		draw color (0, 1 or 2)
+*/
+static void u8g2_ll_fill_span(uint8_t *ptr, u8g2_uint_t len, uint8_t mask, uint8_t color)
+{
+  u8g2_uint_t i;
+  
+  if ( mask == 0x0ff && color <= 1 )
+  {
+    memset(ptr, color == 0 ? 0 : 0x0ff, len);
+    return;
+  }
+  
+  if ( color == 0 )
+  {
+    mask = ~mask;
+    for( i = 0; i < len; i++ )
+      ptr[i] &= mask;
+  }
+  else if ( color == 1 )
+  {
+    for( i = 0; i < len; i++ )
+      ptr[i] |= mask;
+  }
+  else
+  {
+    for( i = 0; i < len; i++ )
+      ptr[i] ^= mask;
+  }
+}
+
+/*
+  x,y		Upper left position of the box within the local buffer (not the display!)
+  w,h		width and height of the box in pixel, both must not be 0
+  asumption: 
+    all clipping done
+*/
+void u8g2_ll_box_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  uint16_t offset;
+  uint16_t stride;
+  uint8_t *ptr;
+  uint8_t bit_pos, cnt, mask;
+  
+  /* bytes are vertical, lsb on top (y=0), msb at bottom (y=7) */
+  stride = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  stride *= 8;
+  
+  offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
+  offset &= ~7;
+  offset *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  ptr = u8g2->tile_buf_ptr;
+  ptr += offset;
+  ptr += x;
+  
+  bit_pos = y;
+  bit_pos &= 7;
+  do
+  {
+    /* number of rows of the box within the current page */
+    cnt = 8 - bit_pos;
+    if ( h < cnt )
+      cnt = h;
+    
+    mask = 0x0ff;
+    mask >>= 8 - cnt;
+    mask <<= bit_pos;
+    u8g2_ll_fill_span(ptr, w, mask, u8g2->draw_color);
+    
+    h -= cnt;
+    bit_pos = 0;
+    ptr += stride;
+  } while( h != 0 );
+}
+
+/*
+  x,y		Upper left position of the box within the local buffer (not the display!)
+  w,h		width and height of the box in pixel, both must not be 0
+  asumption: 
+    all clipping done
+*/
+/* SH1122, LD7032, ST7920, ST7986, LC7981, T6963, SED1330, RA8835, MAX7219, LS0 */ 
+void u8g2_ll_box_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  uint16_t offset;
+  uint8_t *ptr;
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t color = u8g2->draw_color;
+  uint8_t left_mask, right_mask;
+  u8g2_uint_t x1, cnt;
+  
+  /* bytes are horizontal, msb on the left */
+  x1 = x;
+  x1 += w;
+  x1--;			/* last pixel of the box, included */
+  left_mask = 0x0ff >> (x & 7);
+  right_mask = 0x0ff << (7 - (x1 & 7));
+  cnt = (x1 >> 3) - (x >> 3);	/* number of bytes after the first byte */
+  if ( cnt == 0 )
+    left_mask &= right_mask;
+  
+  offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
+  offset *= tile_width;
+  offset += x>>3;
+  ptr = u8g2->tile_buf_ptr;
+  ptr += offset;
+  
+  do
+  {
+    u8g2_ll_fill_span(ptr, 1, left_mask, color);
+    if ( cnt > 0 )
+    {
+      if ( cnt > 1 )
+	u8g2_ll_fill_span(ptr+1, cnt-1, 0x0ff, color);
+      u8g2_ll_fill_span(ptr+cnt, 1, right_mask, color);
+    }
+    ptr += tile_width;
+    h--;
+  } while( h != 0 );
+}
+
+#endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
+
+/*=================================================*/
+/*
+  u8g2_BeginArea
+  u8g2_ClearArea
+  u8g2_EndArea
+  
+  The low level procedures are replaced by procedures, which extend the 
+  bounding box of the area and then clip against the rectangle of the area.
+*/
+
+static void u8g2_area_add(u8g2_area_t *area, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  if ( area->bbox_x0 == area->bbox_x1 )
+  {
+    area->bbox_x0 = x;
+    area->bbox_y0 = y;
+    area->bbox_x1 = x + w;
+    area->bbox_y1 = y + h;
+    return;
+  }
+  if ( area->bbox_x0 > x )
+    area->bbox_x0 = x;
+  if ( area->bbox_y0 > y )
+    area->bbox_y0 = y;
+  if ( area->bbox_x1 < x + w )
+    area->bbox_x1 = x + w;
+  if ( area->bbox_y1 < y + h )
+    area->bbox_y1 = y + h;
+}
+
+static void u8g2_ll_box_area(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_area_t *area = u8g2->area;
+  
+  u8g2_area_add(area, x, y, w, h);
+  if ( area->x0 == area->x1 )
+    return;
+  if ( u8g2_clip_intersection2(&x, &w, area->x0, area->x1) == 0 )
+    return;
+  if ( u8g2_clip_intersection2(&y, &h, area->y0, area->y1) == 0 )
+    return;
+  area->ll_box(u8g2, x, y, w, h);
+}
+
+static void u8g2_ll_hvline_area(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  u8g2_area_t *area = u8g2->area;
+  
+  if ( dir == 0 )
+  {
+    u8g2_area_add(area, x, y, len, 1);
+    if ( area->x0 == area->x1 )
+      return;
+    if ( y < area->y0 || y >= area->y1 )
+      return;
+    if ( u8g2_clip_intersection2(&x, &len, area->x0, area->x1) == 0 )
+      return;
+  }
+  else
+  {
+    u8g2_area_add(area, x, y, 1, len);
+    if ( area->x0 == area->x1 )
+      return;
+    if ( x < area->x0 || x >= area->x1 )
+      return;
+    if ( u8g2_clip_intersection2(&y, &len, area->y0, area->y1) == 0 )
+      return;
+  }
+  area->ll_hvline(u8g2, x, y, len, dir);
+}
+
+void u8g2_BeginArea(u8g2_t *u8g2, u8g2_area_t *area, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1)
+{
+  if ( u8g2->area == NULL )
+  {
+    area->ll_hvline = u8g2->ll_hvline;
+    area->ll_box = u8g2->ll_box;
+  }
+  else if ( u8g2->area != area )
+  {
+    area->ll_hvline = u8g2->area->ll_hvline;
+    area->ll_box = u8g2->area->ll_box;
+  }
+  area->x0 = x0;
+  area->y0 = y0;
+  area->x1 = x1;
+  area->y1 = y1;
+  area->bbox_x0 = 0;
+  area->bbox_y0 = 0;
+  area->bbox_x1 = 0;
+  area->bbox_y1 = 0;
+  u8g2->area = area;
+  u8g2->ll_hvline = u8g2_ll_hvline_area;
+  u8g2->ll_box = area->ll_box == NULL ? NULL : u8g2_ll_box_area;
+}
+
+void u8g2_ClearArea(u8g2_t *u8g2)
+{
+  u8g2_area_t *area = u8g2->area;
+  u8g2_uint_t y;
+  uint8_t draw_color = u8g2->draw_color;
+  
+  if ( area == NULL || area->x0 >= area->x1 || area->y0 >= area->y1 )
+    return;
+  u8g2->draw_color = 0;
+  if ( area->ll_box != NULL )
+  {
+    area->ll_box(u8g2, area->x0, area->y0, area->x1 - area->x0, area->y1 - area->y0);
+  }
+  else
+  {
+    for( y = area->y0; y < area->y1; y++ )
+      area->ll_hvline(u8g2, area->x0, y, area->x1 - area->x0, 0);
+  }
+  u8g2->draw_color = draw_color;
+}
+
+void u8g2_EndArea(u8g2_t *u8g2)
+{
+  if ( u8g2->area == NULL )
+    return;
+  u8g2->ll_hvline = u8g2->area->ll_hvline;
+  u8g2->ll_box = u8g2->area->ll_box;
+  u8g2->area = NULL;
+}
@@ -318,7 +318,19 @@ static void pg_DrawPolygon(pg_struct *pg, u8g2_t *u8g2)
   pg_exec(pg, u8g2);
 }
 
-pg_struct u8g2_pg;
+/* 
+  The u8g2_ClearPolygonXY/u8g2_AddPolygonXY/u8g2_DrawPolygon API keeps the
+  points in this global structure. Make it thread local where possible, so 
+  that threads rendering to different displays do not share it. 
+  u8g2_DrawTriangle() and u8g2_DrawFilledPolygon() do not use it at all.
+*/
+#if defined(__GNUC__) && (defined(unix) || defined(__unix__))
+#define PG_THREAD_LOCAL __thread
+#else
+#define PG_THREAD_LOCAL
+#endif
+
+PG_THREAD_LOCAL pg_struct u8g2_pg;
 
 void u8g2_ClearPolygonXY(void)
 {
@@ -337,10 +349,206 @@ void u8g2_DrawPolygon(u8g2_t *u8g2)
 
 void u8g2_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
 {
-  u8g2_ClearPolygonXY();
-  u8g2_AddPolygonXY(u8g2, x0, y0);
-  u8g2_AddPolygonXY(u8g2, x1, y1);
-  u8g2_AddPolygonXY(u8g2, x2, y2);
-  u8g2_DrawPolygon(u8g2);
+  pg_struct pg;		/* local copy, so that this is reentrant */
+  pg_ClearPolygonXY(&pg);
+  pg_AddPolygonXY(&pg, x0, y0);
+  pg_AddPolygonXY(&pg, x1, y1);
+  pg_AddPolygonXY(&pg, x2, y2);
+  pg_DrawPolygon(&pg, u8g2);
+}
+
+/*===========================================*/
+/* 
+  scan line polygon fill with an active edge table 
+  
+  - works for any polygon (concave, self intersecting), even-odd fill rule
+  - a pixel is set, if its center is inside the polygon
+  - all state is kept in the edge array provided by the caller, 
+    which makes this procedure reentrant
+  - edges are stepped with an exact integer DDA: The x position of an edge 
+    at the center of a scan line is x = floor + rem/den, so that there is 
+    no accumulated rounding error for long edges
+*/
+
+/* sort edges by ascending y_min (shell sort, no recursion, no extra memory) */
+static void pg_sort_edges_by_y(u8g2_pg_edge_t *e, uint16_t cnt)
+{
+  uint16_t gap, i, j;
+  u8g2_pg_edge_t t;
+  for( gap = cnt/2; gap > 0; gap /= 2 )
+  {
+    for( i = gap; i < cnt; i++ )
+    {
+      t = e[i];
+      for( j = i; j >= gap && e[j-gap].y_min > t.y_min; j -= gap )
+	e[j] = e[j-gap];
+      e[j] = t;
+    }
+  }
+}
+
+/* first pixel, whose center is right of the edge */
+static int32_t pg_edge_px(const u8g2_pg_edge_t *e)
+{
+  return e->x + (e->rem != 0);
+}
+
+/* sort edges by ascending pixel position (insertion sort, active edges are almost sorted from the previous scan line) */
+static void pg_sort_edges_by_x(u8g2_pg_edge_t *e, uint16_t cnt)
+{
+  uint16_t i, j;
+  u8g2_pg_edge_t t;
+  for( i = 1; i < cnt; i++ )
+  {
+    t = e[i];
+    for( j = i; j > 0 && pg_edge_px(e+j-1) > pg_edge_px(&t); j-- )
+      e[j] = e[j-1];
+    e[j] = t;
+  }
+}
+
+/* floor division with a positive divisor */
+static int32_t pg_floor_div(int64_t a, int32_t d)
+{
+  int64_t q = a / d;
+  if ( a % d < 0 )
+    q--;
+  return (int32_t)q;
+}
+
+/* 
+  setup the DDA for the center of scan line y
+  the edge crosses the scan line at x0 + (y + 1/2 - y0) * dx / dy, 
+  a pixel is inside if its center is right of it, so we track
+  (x - 1/2) = (2*dy*x0 + (2*(y-y0)+1)*dx - dy) / (2*dy)
+*/
+static void pg_edge_start(u8g2_pg_edge_t *e, int32_t y)
+{
+  int64_t v;
+  int32_t dx = (int32_t)e->x1 - e->x0;
+  int32_t dy = (int32_t)e->y_max - e->y_min;
+  
+  e->den = 2*dy;
+  v = (int64_t)e->den * e->x0 + (int64_t)(2*(y - e->y_min) + 1) * dx - dy;
+  e->x = pg_floor_div(v, e->den);
+  e->rem = (int32_t)(v - (int64_t)e->x * e->den);
+  e->x_step = pg_floor_div(2*(int64_t)dx, e->den);
+  e->rem_step = 2*dx - e->x_step * e->den;
+}
+
+static void pg_edge_next(u8g2_pg_edge_t *e)
+{
+  e->x += e->x_step;
+  e->rem += e->rem_step;
+  if ( e->rem >= e->den )
+  {
+    e->x++;
+    e->rem -= e->den;
+  }
+}
+
+void u8g2_DrawFilledPolygon(u8g2_t *u8g2, const u8g2_xy_t *points, uint16_t cnt, u8g2_pg_edge_t *edges)
+{
+  u8g2_pg_edge_t stack_edges[U8G2_PG_STACK_EDGES];
+  u8g2_pg_edge_t *e;
+  uint16_t i, n, first_active, next_edge;
+  int32_t y, y_end, xl, xr, w;
+  int16_t y_min, y_max;
+  
+  if ( cnt < 3 )
+    return;
+  if ( edges == NULL )
+  {
+    if ( cnt > U8G2_PG_STACK_EDGES )
+      return;
+    edges = stack_edges;
+  }
+  
+  /* build the edge table, horizontal edges are ignored */
+  n = 0;
+  y_min = points[0].y;
+  y_max = points[0].y;
+  for( i = 0; i < cnt; i++ )
+  {
+    const u8g2_xy_t *a = points + i;
+    const u8g2_xy_t *b = points + (i + 1 == cnt ? 0 : i + 1);
+    if ( a->y == b->y )
+      continue;
+    if ( a->y > b->y )
+    {
+      const u8g2_xy_t *t = a;
+      a = b;
+      b = t;
+    }
+    e = edges + n;
+    e->x0 = a->x;
+    e->x1 = b->x;
+    e->y_min = a->y;
+    e->y_max = b->y;
+    n++;
+    if ( y_min > a->y )
+      y_min = a->y;
+    if ( y_max < b->y )
+      y_max = b->y;
+  }
+  if ( n < 2 )
+    return;
+  pg_sort_edges_by_y(edges, n);
+  
+  /* clip the scan lines once for the whole polygon */
+  y = y_min;
+  if ( y < 0 )
+    y = 0;
+  y_end = y_max;
+  if ( y_end > (int32_t)u8g2_GetDisplayHeight(u8g2) )
+    y_end = u8g2_GetDisplayHeight(u8g2);
+  w = u8g2_GetDisplayWidth(u8g2);
+  
+  /* edges[first_active..next_edge-1] is the active edge table */
+  first_active = 0;
+  next_edge = 0;
+  for( ; y < y_end; y++ )
+  {
+    /* add edges which start at or above this scan line */
+    while( next_edge < n && edges[next_edge].y_min <= y )
+    {
+      pg_edge_start(edges + next_edge, y);
+      next_edge++;
+    }
+    /* remove edges which end at or above this scan line */
+    for( i = first_active; i < next_edge; i++ )
+    {
+      if ( edges[i].y_max <= y )
+      {
+	u8g2_pg_edge_t t = edges[i];
+	edges[i] = edges[first_active];
+	edges[first_active] = t;
+	first_active++;
+      }
+    }
+    if ( first_active == next_edge )
+    {
+      if ( next_edge == n )
+	break;
+      continue;
+    }
+    
+    /* fill between pairs of intersections */
+    pg_sort_edges_by_x(edges + first_active, next_edge - first_active);
+    for( i = first_active; i + 1 < next_edge; i += 2 )
+    {
+      xl = pg_edge_px(edges + i);
+      xr = pg_edge_px(edges + i + 1);
+      if ( xl < 0 )
+	xl = 0;
+      if ( xr > w )
+	xr = w;
+      if ( xl < xr )
+	u8g2_DrawHVLine(u8g2, (u8g2_uint_t)xl, (u8g2_uint_t)y, (u8g2_uint_t)(xr - xl), 0);
+    }
+    
+    for( i = first_active; i < next_edge; i++ )
+      pg_edge_next(edges + i);
+  }
 }
 
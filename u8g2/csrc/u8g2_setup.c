@@ -77,8 +77,20 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
   //u8g2->ll_hvline = u8g2_ll_hvline_vertical_top_lsb;
   u8g2->ll_hvline = ll_hvline_cb;
   
+  /* the box procedure must match the memory layout of the hvline procedure */
+  u8g2->ll_box = NULL;
+#ifdef U8G2_WITH_HVLINE_SPEED_OPTIMIZATION
+  if ( ll_hvline_cb == u8g2_ll_hvline_vertical_top_lsb )
+    u8g2->ll_box = u8g2_ll_box_vertical_top_lsb;
+  else if ( ll_hvline_cb == u8g2_ll_hvline_horizontal_right_lsb )
+    u8g2->ll_box = u8g2_ll_box_horizontal_right_lsb;
+#endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
+  
   u8g2->tile_buf_ptr = buf;
   u8g2->tile_buf_height = tile_buf_height;
+  u8g2->flush_rotation = NULL;
+  u8g2->gray = NULL;
+  u8g2->area = NULL;
   
   u8g2->tile_curr_row = 0;
   
@@ -464,6 +476,25 @@ void u8g2_Setup_null(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_c
   u8g2_SetupBuffer(u8g2, buf, 1, u8g2_ll_hvline_vertical_top_lsb, rotation);
 }
 
+/*
+  setup for a canvas: a full buffer of tile_width x tile_height tiles on the 
+  null device, which is not sent anywhere but copied into the buffers of 
+  other displays with u8g2_CopyBufferTiles(), e.g. for a video wall.
+  "info" is filled here and must stay valid as long as u8g2 is used, "buf" 
+  must have 8*tile_width*tile_height bytes.
+*/
+void u8g2_SetupCanvas(u8g2_t *u8g2, u8x8_display_info_t *info, uint8_t tile_width, uint8_t tile_height, uint8_t *buf, const u8g2_cb_t *rotation)
+{
+  u8g2_SetupDisplay(u8g2, u8x8_d_null_cb, u8x8_cad_empty, u8x8_dummy_cb, u8x8_dummy_cb);
+  *info = *u8g2_GetU8x8(u8g2)->display_info;
+  info->tile_width = tile_width;
+  info->tile_height = tile_height;
+  info->pixel_width = (uint16_t)tile_width * 8;
+  info->pixel_height = (uint16_t)tile_height * 8;
+  u8g2_GetU8x8(u8g2)->display_info = info;
+  u8g2_SetupBuffer(u8g2, buf, tile_height, u8g2_ll_hvline_vertical_top_lsb, rotation);
+}
+
 
   
   
\ No newline at end of file
@@ -50,39 +50,63 @@ static uint8_t u8log_is_on_screen(u8log_t *u8log, uint8_t x, uint8_t y)
 }
 */
 
+uint8_t *u8log_GetLine(u8log_t *u8log, uint8_t y)
+{
+  uint16_t line = u8log->first_line;
+  line += y;
+  if ( line >= u8log->height )
+    line -= u8log->height;
+  line *= u8log->width;
+  return u8log->screen_buffer + line;
+}
+
+/* remember that screen line y has to be drawn again */
+static void u8log_mark_changed(u8log_t *u8log, uint8_t y)
+{
+  if ( u8log->changed_y0 >= u8log->changed_y1 )
+  {
+    u8log->changed_y0 = y;
+    u8log->changed_y1 = y + 1;
+  }
+  else if ( y < u8log->changed_y0 )
+    u8log->changed_y0 = y;
+  else if ( y >= u8log->changed_y1 )
+    u8log->changed_y1 = y + 1;
+}
+
 static void u8log_clear_screen(u8log_t *u8log)
 {
-  uint8_t *dest = u8log->screen_buffer;
   uint16_t cnt = u8log->height;
   cnt *= u8log->width;
-  do
-  {
-    *dest++ = ' ';
-    cnt--;
-  } while( cnt > 0 );
-  
+  memset(u8log->screen_buffer, ' ', cnt);
+  u8log->first_line = 0;
+  u8log->scroll_cnt = 0;
+  u8log->changed_y0 = 0;
+  u8log->changed_y1 = u8log->height;
 }
 
 
-/* scroll the content of the complete buffer, set redraw_line to 255 */
+/* 
+  scroll the content of the complete buffer: the top line becomes the
+  new (empty) bottom line, the other lines are not moved
+*/
 static void u8log_scroll_up(u8log_t *u8log)
 {
-  uint8_t *dest = u8log->screen_buffer;
-  uint8_t *src = dest+u8log->width;
-  uint16_t cnt = u8log->height;
-  cnt--;
-  cnt *= u8log->width;
-  do
-  {
-    *dest++ = *src++;
-    cnt--;
-  } while( cnt > 0 );
-  cnt = u8log->width;
-  do
+  memset(u8log_GetLine(u8log, 0), ' ', u8log->width);
+  u8log->first_line++;
+  if ( u8log->first_line >= u8log->height )
+    u8log->first_line = 0;
+  if ( u8log->scroll_cnt < u8log->height )
+    u8log->scroll_cnt++;
+  
+  /* the changed lines move up with the content */
+  if ( u8log->changed_y0 < u8log->changed_y1 )
   {
-    *dest++ = ' ';
-    cnt--;
-  } while(cnt > 0);
+    if ( u8log->changed_y0 > 0 )
+      u8log->changed_y0--;
+    u8log->changed_y1--;
+  }
+  u8log_mark_changed(u8log, u8log->height - 1);
   
   if ( u8log->is_redraw_line_for_each_char )
     u8log->is_redraw_all = 1;
@@ -114,7 +138,8 @@ static void u8log_cursor_on_screen(u8log_t *u8log)
 static void u8log_write_to_screen(u8log_t *u8log, uint8_t c)
 {
   u8log_cursor_on_screen(u8log);
-  u8log->screen_buffer[u8log->cursor_y * u8log->width + u8log->cursor_x] = c;
+  u8log_GetLine(u8log, u8log->cursor_y)[u8log->cursor_x] = c;
+  u8log_mark_changed(u8log, u8log->cursor_y);
   u8log->cursor_x++;
   
   if ( u8log->is_redraw_line_for_each_char )
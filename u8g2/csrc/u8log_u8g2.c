@@ -35,6 +35,16 @@
 */
 
 #include "u8g2.h"
+
+static void u8g2_draw_log_line(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log, uint8_t buf_y)
+{
+  const uint8_t *line = u8log_GetLine(u8log, buf_y);
+  uint8_t buf_x;
+  
+  for( buf_x = 0; buf_x < u8log->width; buf_x++ )
+    x += u8g2_DrawGlyph(u8g2, x, y, line[buf_x]);
+}
+
 /*
   Draw the u8log text at the specified x/y position.
   x/y position is the reference position of the first char of the first line.
@@ -50,23 +60,72 @@
 */
 void u8g2_DrawLog(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log)
 {
-  u8g2_uint_t disp_x, disp_y;
-  uint8_t buf_x, buf_y;
-  uint8_t c;
+  u8g2_uint_t disp_y;
+  uint8_t buf_y;
   
   disp_y = y;  
   u8g2_SetFontDirection(u8g2, 0);
   for( buf_y = 0; buf_y < u8log->height; buf_y++ )
   {
-    disp_x = x;
-    for( buf_x = 0; buf_x < u8log->width; buf_x++ )
-    {
-      c = u8log->screen_buffer[buf_y * u8log->width + buf_x];
-      disp_x += u8g2_DrawGlyph(u8g2, disp_x, disp_y, c);
-    }
+    u8g2_draw_log_line(u8g2, x, disp_y, u8log, buf_y);
     disp_y += u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2);
     disp_y += u8log->line_height_offset;
   }
+  /* everything is drawn, u8g2_DrawLogChanges() continues from here */
+  u8log->scroll_cnt = 0;
+  u8log->changed_y0 = 0;
+  u8log->changed_y1 = 0;
+}
+
+/*
+  Update a full buffer, which shows the log (drawn with u8g2_DrawLog() 
+  and the same x/y position and font), to the current content of the 
+  log: the buffer is moved up by the lines which were scrolled since the 
+  last draw and only the changed lines are drawn again. The background of 
+  each changed line is cleared up to the right edge of the display.
+  The log should cover the whole display, because the whole buffer is 
+  scrolled. With rotate at flush the display start line follows the 
+  scrolling, so that only the new lines are transfered. The buffer can 
+  only be moved up for U8G2_R0 (also used by rotate at flush), with other 
+  rotations all lines are drawn again.
+*/
+void u8g2_DrawLogChanges(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log)
+{
+  u8g2_uint_t line_height, top, dy;
+  uint8_t buf_y, draw_color;
+  
+  line_height = u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2);
+  line_height += u8log->line_height_offset;
+  if ( u8log->scroll_cnt != 0 )
+  {
+    dy = line_height;
+    dy *= u8log->scroll_cnt;
+    if ( u8log->scroll_cnt < u8log->height && u8g2->cb == U8G2_R0 && u8g2_ScrollBufferUp(u8g2, dy) != 0 )
+    {
+      u8g2_ScrollFlushRotation(u8g2, 0, -(u8g2_int_t)dy);
+    }
+    else
+    {
+      u8log->changed_y0 = 0;
+      u8log->changed_y1 = u8log->height;
+    }
+  }
+  
+  draw_color = u8g2->draw_color;
+  u8g2_SetFontDirection(u8g2, 0);
+  for( buf_y = u8log->changed_y0; buf_y < u8log->changed_y1; buf_y++ )
+  {
+    top = y;
+    top -= u8g2_GetAscent(u8g2);
+    top += buf_y * line_height;
+    u8g2_SetDrawColor(u8g2, 0);
+    u8g2_DrawBox(u8g2, x, top, u8g2_GetDisplayWidth(u8g2) - x, line_height);
+    u8g2_SetDrawColor(u8g2, draw_color);
+    u8g2_draw_log_line(u8g2, x, y + buf_y * line_height, u8log, buf_y);
+  }
+  u8log->scroll_cnt = 0;
+  u8log->changed_y0 = 0;
+  u8log->changed_y1 = 0;
 }
 
 /*
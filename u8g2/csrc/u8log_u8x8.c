@@ -43,7 +43,7 @@ static void u8x8_DrawLogLine(u8x8_t *u8x8, uint8_t disp_x, uint8_t disp_y, uint8
   uint8_t c;
   for( buf_x = 0; buf_x < u8log->width; buf_x++ )
   {
-    c = u8log->screen_buffer[buf_y * u8log->width + buf_x];
+    c = u8log_GetLine(u8log, buf_y)[buf_x];
     u8x8_DrawGlyph(u8x8, disp_x, disp_y, c);
     disp_x++;
   }
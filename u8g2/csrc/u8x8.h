@@ -211,6 +211,7 @@ uint8_t u8x8_pgm_read_esp(const uint8_t * addr);   /* u8x8_8x8.c */
 typedef struct u8x8_struct u8x8_t;
 typedef struct u8x8_display_info_struct u8x8_display_info_t;
 typedef struct u8x8_tile_struct u8x8_tile_t;
+typedef struct u8x8_gray_area_struct u8x8_gray_area_t;
 
 typedef uint8_t (*u8x8_msg_cb)(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 typedef uint16_t (*u8x8_char_cb)(u8x8_t *u8x8, uint8_t b);
@@ -233,6 +234,15 @@ struct u8x8_tile_struct
   uint8_t y_pos;	/* tile y position */
 };
 
+struct u8x8_gray_area_struct
+{
+  uint8_t *ptr;		/* first byte of the first row, two pixels per byte */
+  uint16_t stride;	/* bytes from one row to the next */
+  uint8_t cnt;		/* number of bytes in each row */
+  uint8_t x_pos;	/* first byte column (pixel x / 2) */
+  uint8_t y_pos;	/* first pixel row */
+};
+
 
 struct u8x8_display_info_struct
 {
@@ -357,6 +367,9 @@ struct u8x8_struct
 					/* usually, the lowest bit must be zero for a valid address */
   uint8_t i2c_bus; /* the i2c bus, when more than one is available and can be selected */
   uint8_t i2c_started;	/* for i2c interface */
+  uint8_t cad_in_transfer;	/* cad procedures, which keep a transfer open between commands */
+  uint8_t cad_is_data;	/* cad procedures, which encode the DC bit into the i2c address */
+  uint8_t display_start_line;	/* SSD13xx, SH1106: RAM line shown at the top of the display */
   //uint8_t device_address;	/* OBSOLETE???? - this is the device address, replacement for U8X8_MSG_CAD_SET_DEVICE */
   uint8_t utf8_state;		/* number of chars which are still to scan */
   uint8_t gpio_result;	/* return value from the gpio call (only for MENU keys at the moment) */ 
@@ -422,7 +435,7 @@ struct u8log_struct
   void *aux_data;		/* pointer to u8x8 or u8g2 */
   uint8_t width, height;	/* size of the terminal */
   u8log_cb cb;			/* callback redraw function */
-  uint8_t *screen_buffer;	/* size must be width*height bytes */
+  uint8_t *screen_buffer;	/* size must be width*height bytes, a ring of lines starting at first_line */
   uint8_t is_redraw_line_for_each_char;
   int8_t line_height_offset;		/* extra offset for the line height (u8g2 only) */
   
@@ -433,6 +446,9 @@ struct u8log_struct
   uint8_t is_redraw_line;
   uint8_t is_redraw_all;
   uint8_t is_redraw_all_required_for_next_nl; /* in nl mode, redraw all instead of current line */
+  uint8_t first_line;		/* line of screen_buffer which is shown at the top */
+  uint8_t scroll_cnt;		/* lines scrolled up since the last u8g2_DrawLog()/u8g2_DrawLogChanges() */
+  uint8_t changed_y0, changed_y1;	/* screen lines changed since then, none if changed_y0 >= changed_y1 */
 };
 
 
@@ -442,6 +458,9 @@ struct u8log_struct
 void u8x8_d_helper_display_setup_memory(u8x8_t *u8x8, const u8x8_display_info_t *display_info);
 void u8x8_d_helper_display_init(u8x8_t *u8g2);
 
+/* u8x8_d_ssd1306_128x64_noname.c: U8X8_MSG_DISPLAY_DRAW_TILE_AREA with the horizontal addressing mode */
+uint8_t u8x8_d_ssd13xx_draw_tile_area(u8x8_t *u8x8, uint8_t rows, u8x8_tile_t *tile, uint8_t addressing_mode);
+
 /* Display Interface */
 
 /*
@@ -539,6 +558,102 @@ void u8x8_d_helper_display_init(u8x8_t *u8g2);
 */
 #define U8X8_MSG_DISPLAY_REFRESH 16
 
+/*
+  Name: 	U8X8_MSG_DISPLAY_DRAW_TILE_AREA
+  Args:	
+    arg_int: number of tile rows
+    arg_ptr: pointer to u8x8_tile_t
+        uint8_t *tile_ptr;	pointer to the tiles of the first row
+	uint8_t cnt;		number of tiles in each row
+	uint8_t x_pos;		first tile x position
+	uint8_t y_pos;		first tile y position 
+  Tasks:
+    Draw a rectangle of cnt x arg_int tiles. Row r of the rectangle starts
+    at tile_ptr + r*8*display_info->tile_width, which is the layout of
+    the u8g2 buffer.
+    Controllers with an auto incrementing address window (SSD1306, SSD1309)
+    can set the window once and send all rows as one data stream.
+    Return 0 if the message is not supported for this area: Use
+      uint8_t u8x8_DrawTileArea(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *tile_ptr)
+    which falls back to one U8X8_MSG_DISPLAY_DRAW_TILE per row.
+*/
+#define U8X8_MSG_DISPLAY_DRAW_TILE_AREA 17
+
+/*
+  Name: 	U8X8_MSG_DISPLAY_SET_START_LINE
+  Args:	
+    arg_int: RAM line, which is shown at the top of the display
+    arg_ptr: -
+  Tasks:
+    Scroll the display vertically with the display start line register
+    and store the line in u8x8->display_start_line. The display RAM is not 
+    changed. Return 0 if the controller does not support this. Use
+      uint8_t u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line)
+    to send this message. U8X8_MSG_DISPLAY_INIT resets the start line to 0.
+*/
+#define U8X8_MSG_DISPLAY_SET_START_LINE 18
+
+/*
+  Name: 	U8X8_MSG_DISPLAY_SET_PIXEL_MODE
+  Args:	
+    arg_int: U8X8_PIXEL_MODE_NORMAL or a combination of
+      U8X8_PIXEL_MODE_INVERSE: show the display RAM inverted
+      U8X8_PIXEL_MODE_ALL_ON: light all pixels, ignoring the display RAM
+    arg_ptr: -
+  Tasks:
+    Change how the controller shows its RAM without changing the RAM.
+    This is a short command write, so it can be used for flashes and 
+    blinks without sending the frame again. Return 0 if the controller 
+    does not support this. Use
+      uint8_t u8x8_SetPixelMode(u8x8_t *u8x8, uint8_t mode)
+    to send this message.
+*/
+#define U8X8_MSG_DISPLAY_SET_PIXEL_MODE 19
+
+#define U8X8_PIXEL_MODE_NORMAL 0
+#define U8X8_PIXEL_MODE_INVERSE 1
+#define U8X8_PIXEL_MODE_ALL_ON 2
+
+/*
+  Name: 	U8X8_MSG_DISPLAY_SCROLL_COLUMN
+  Args:	
+    arg_int: U8X8_SCROLL_COLUMN_RIGHT or U8X8_SCROLL_COLUMN_LEFT, 
+      U8X8_SCROLL_COLUMN_CHECK only checks whether this is supported
+    arg_ptr: -
+  Tasks:
+    Move the content of the display RAM by one column to higher 
+    (U8X8_SCROLL_COLUMN_RIGHT) or lower column addresses, on all pages.
+    The content of the column which is moved in is undefined. Return 
+    once the RAM has moved, so that it can be written to straight away.
+    Return 0 if the controller does not support this. Use
+      uint8_t u8x8_ScrollDisplayColumn(u8x8_t *u8x8, uint8_t dir)
+    to send this message.
+    The value is not used by any other message.
+*/
+#define U8X8_MSG_DISPLAY_SCROLL_COLUMN 8
+
+#define U8X8_SCROLL_COLUMN_CHECK 0
+#define U8X8_SCROLL_COLUMN_RIGHT 1
+#define U8X8_SCROLL_COLUMN_LEFT 2
+
+/*
+  Name: 	U8X8_MSG_DISPLAY_DRAW_GRAY_AREA
+  Args:	
+    arg_int: number of pixel rows
+    arg_ptr: pointer to u8x8_gray_area_t
+        uint8_t *ptr;		pointer to the first byte of the first row
+	uint16_t stride;	bytes from one row to the next
+	uint8_t cnt;		number of bytes in each row
+	uint8_t x_pos;		first byte column (pixel x / 2)
+	uint8_t y_pos;		first pixel row
+  Tasks:
+    Write a rectangle of 4bpp pixels to the display RAM of a 16 level
+    controller. Each byte contains two pixels, the left one in the upper
+    nibble. Return 0 if the controller does not support this. 
+    The value is not used by any other message: 20 and up are CAD messages.
+*/
+#define U8X8_MSG_DISPLAY_DRAW_GRAY_AREA 12
+
 /*==========================================*/
 /* u8x8_setup.c */
 
@@ -557,6 +672,7 @@ void u8x8_Setup(u8x8_t *u8x8, u8x8_msg_cb display_cb, u8x8_msg_cb cad_cb, u8x8_m
 /*==========================================*/
 /* u8x8_display.c */
 uint8_t u8x8_DrawTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr);
+uint8_t u8x8_DrawTileArea(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *tile_ptr);
 
 /* 
   After a call to u8x8_SetupDefaults, 
@@ -588,6 +704,9 @@ void u8x8_SetContrast(u8x8_t *u8x8, uint8_t value);
 void u8x8_ClearDisplayWithTile(u8x8_t *u8x8, const uint8_t *buf)  U8X8_NOINLINE;
 void u8x8_ClearDisplay(u8x8_t *u8x8);	// this does not work for u8g2 in some cases
 void u8x8_FillDisplay(u8x8_t *u8x8);
+uint8_t u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line);	/* returns 0 if not supported by the controller */
+uint8_t u8x8_SetPixelMode(u8x8_t *u8x8, uint8_t mode);	/* returns 0 if not supported by the controller */
+uint8_t u8x8_ScrollDisplayColumn(u8x8_t *u8x8, uint8_t dir);	/* returns 0 if not supported by the controller */
 void u8x8_RefreshDisplay(u8x8_t *u8x8);	// make RAM content visible on the display (Dec 16: SSD1606 only)
 void u8x8_ClearLine(u8x8_t *u8x8, uint8_t line);
 
@@ -1131,6 +1250,7 @@ void u8log_WriteHex16(u8log_t *u8log, uint16_t v);
 void u8log_WriteHex32(u8log_t *u8log, uint32_t v);
 void u8log_WriteDec8(u8log_t *u8log, uint8_t v, uint8_t d);
 void u8log_WriteDec16(u8log_t *u8log, uint16_t v, uint8_t d);
+uint8_t *u8log_GetLine(u8log_t *u8log, uint8_t y);	/* chars of screen line y */
 
 /*==========================================*/
 /* u8log_u8x8.c */
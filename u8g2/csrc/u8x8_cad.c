@@ -533,7 +533,6 @@ uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
 /* fast version with reduced data start/stops, issue 735 */
 uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  static uint8_t in_transfer = 0;
   uint8_t *p;
   switch(msg)
   {
@@ -541,13 +540,13 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
       /* improved version, takeover from ld7032 */
       /* assumes, that the args of a command is not longer than 31 bytes */
       /* speed improvement is about 4% compared to the classic version */
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	 u8x8_byte_EndTransfer(u8x8); 
       
       u8x8_byte_StartTransfer(u8x8);
       u8x8_byte_SendByte(u8x8, 0x000);	/* cmd byte for ssd13xx controller */
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
+      u8x8->cad_in_transfer = 1;
       /* lightning version: can replace the improved version from above */
       /* the drawback of the lightning version is this: The complete init sequence */
       /* must fit into the 32 byte Arduino Wire buffer, which might not always be the case */
@@ -564,7 +563,7 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
       u8x8_byte_SendByte(u8x8, arg_int);
       break;      
     case U8X8_MSG_CAD_SEND_DATA:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8); 
       
     
@@ -583,7 +582,7 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
 	p+=24;
       }
       u8x8_i2c_data_transfer(u8x8, arg_int, p);
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     case U8X8_MSG_CAD_INIT:
       /* apply default i2c adr if required so that the start transfer msg can use this */
@@ -591,12 +590,12 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
 	u8x8->i2c_address = 0x078;
       return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
     case U8X8_MSG_CAD_START_TRANSFER:
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     case U8X8_MSG_CAD_END_TRANSFER:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8); 
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     default:
       return 0;
@@ -656,16 +655,15 @@ uint8_t u8x8_cad_st75256_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
 /* Workaround is to remove the while loop (or increase the value in the condition) */
 uint8_t u8x8_cad_ld7032_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  static uint8_t in_transfer = 0;
   uint8_t *p;
   switch(msg)
   {
     case U8X8_MSG_CAD_SEND_CMD:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8); 
       u8x8_byte_StartTransfer(u8x8);
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
+      u8x8->cad_in_transfer = 1;
       break;
     case U8X8_MSG_CAD_SEND_ARG:
       u8x8_byte_SendByte(u8x8, arg_int);
@@ -698,10 +696,10 @@ uint8_t u8x8_cad_ld7032_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8->i2c_address = 0x060;
       return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
     case U8X8_MSG_CAD_START_TRANSFER:
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     case U8X8_MSG_CAD_END_TRANSFER:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8); 
       break;
     default:
@@ -715,16 +713,14 @@ uint8_t u8x8_cad_ld7032_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 /* DC bit is encoded into the adr byte, structure is CAD001 */
 uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  static uint8_t in_transfer = 0;	
-  static uint8_t is_data = 0;
   uint8_t *p;
   switch(msg)
   {
     case U8X8_MSG_CAD_SEND_CMD:
     case U8X8_MSG_CAD_SEND_ARG:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
       {
-	if ( is_data != 0 )
+	if ( u8x8->cad_is_data != 0 )
 	{
 	  /* transfer mode is active, but data transfer */
 	  u8x8_byte_EndTransfer(u8x8); 
@@ -740,13 +736,13 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8_byte_StartTransfer(u8x8);
       }
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
+      u8x8->cad_in_transfer = 1;
       // is_data = 0;  // 20 Jun 2021: I assume that this is missing here
       break;
     case U8X8_MSG_CAD_SEND_DATA:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
       {
-	if ( is_data == 0 )
+	if ( u8x8->cad_is_data == 0 )
 	{
 	  /* transfer mode is active, but data transfer */
 	  u8x8_byte_EndTransfer(u8x8); 
@@ -761,7 +757,7 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8_SetI2CAddress( u8x8, (u8x8_GetI2CAddress(u8x8)&0x0fc)|2 );
 	u8x8_byte_StartTransfer(u8x8);
       }
-      in_transfer = 1;
+      u8x8->cad_in_transfer = 1;
       // is_data = 1;  // 20 Jun 2021: I assume that this is missing here
       
       p = arg_ptr;
@@ -782,13 +778,13 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8->i2c_address = 0x070;
       return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
     case U8X8_MSG_CAD_START_TRANSFER:
-      in_transfer = 0;    
+      u8x8->cad_in_transfer = 0;    
       /* actual start is delayed, because we do not whether this is data or cmd transfer */
       break;
     case U8X8_MSG_CAD_END_TRANSFER:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8);
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     default:
       return 0;
@@ -801,15 +797,13 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 /* same as  u8x8_cad_uc16xx_i2c but CAD structure is CAD011 */
 uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  static uint8_t in_transfer = 0;	
-  static uint8_t is_data = 0;
   uint8_t *p;
   switch(msg)
   {
     case U8X8_MSG_CAD_SEND_CMD:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
       {
-	if ( is_data != 0 )
+	if ( u8x8->cad_is_data != 0 )
 	{
 	  /* transfer mode is active, but data transfer */
 	  u8x8_byte_EndTransfer(u8x8); 
@@ -825,13 +819,13 @@ uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8_byte_StartTransfer(u8x8);
       }
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
-      is_data = 0;
+      u8x8->cad_in_transfer = 1;
+      u8x8->cad_is_data = 0;
       break;
     case U8X8_MSG_CAD_SEND_ARG:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
       {
-	if ( is_data == 0 )
+	if ( u8x8->cad_is_data == 0 )
 	{
 	  /* transfer mode is active, but data transfer */
 	  u8x8_byte_EndTransfer(u8x8); 
@@ -847,13 +841,13 @@ uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8_byte_StartTransfer(u8x8);
       }
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
-      is_data = 1;
+      u8x8->cad_in_transfer = 1;
+      u8x8->cad_is_data = 1;
       break;
     case U8X8_MSG_CAD_SEND_DATA:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
       {
-	if ( is_data == 0 )
+	if ( u8x8->cad_is_data == 0 )
 	{
 	  /* transfer mode is active, but data transfer */
 	  u8x8_byte_EndTransfer(u8x8); 
@@ -868,8 +862,8 @@ uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8_SetI2CAddress( u8x8, (u8x8_GetI2CAddress(u8x8)&0x0fc)|2 );
 	u8x8_byte_StartTransfer(u8x8);
       }
-      in_transfer = 1;
-      is_data = 1;
+      u8x8->cad_in_transfer = 1;
+      u8x8->cad_is_data = 1;
       
       p = arg_ptr;
       while( arg_int > 24 )
@@ -889,13 +883,13 @@ uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8->i2c_address = 0x078;  /* see also https://github.com/olikraus/u8g2/issues/371 for a discussion on this value */
       return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
     case U8X8_MSG_CAD_START_TRANSFER:
-      in_transfer = 0;    
+      u8x8->cad_in_transfer = 0;    
       /* actual start is delayed, because we do not whether this is data or cmd transfer */
       break;
     case U8X8_MSG_CAD_END_TRANSFER:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8);
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     default:
       return 0;
@@ -294,13 +294,25 @@ static uint8_t u8x8_d_ssd1306_sh1106_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
       u8x8_cad_EndTransfer(u8x8);
       break;
 #endif
+    case U8X8_MSG_DISPLAY_SET_START_LINE:
+      u8x8->display_start_line = arg_int & 63;
+      u8x8_cad_StartTransfer(u8x8);
+      u8x8_cad_SendCmd(u8x8, 0x040 | u8x8->display_start_line );
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+    case U8X8_MSG_DISPLAY_SET_PIXEL_MODE:
+      u8x8_cad_StartTransfer(u8x8);
+      u8x8_cad_SendCmd(u8x8, (arg_int & U8X8_PIXEL_MODE_INVERSE) ? 0x0a7 : 0x0a6 );	/* inverse display */
+      u8x8_cad_SendCmd(u8x8, (arg_int & U8X8_PIXEL_MODE_ALL_ON) ? 0x0a5 : 0x0a4 );	/* entire display on */
+      u8x8_cad_EndTransfer(u8x8);
+      break;
     case U8X8_MSG_DISPLAY_DRAW_TILE:
       u8x8_cad_StartTransfer(u8x8);
       x = ((u8x8_tile_t *)arg_ptr)->x_pos;    
       x *= 8;
       x += u8x8->x_offset;
     
-      u8x8_cad_SendCmd(u8x8, 0x040 );	/* set line offset to 0 */
+      u8x8_cad_SendCmd(u8x8, 0x040 | u8x8->display_start_line );	/* keep the line offset */
     
       u8x8_cad_SendCmd(u8x8, 0x010 | (x>>4) );
       u8x8_cad_SendArg(u8x8, 0x000 | ((x&15)));					/* probably wrong, should be SendCmd */
@@ -332,6 +344,77 @@ static uint8_t u8x8_d_ssd1306_sh1106_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
 }
 
 
+/*
+  U8X8_MSG_DISPLAY_DRAW_TILE_AREA for SSD1306 and SSD1309:
+  use the horizontal addressing mode, set the column and page window once 
+  and send all tile rows as one data stream. Afterwards the full window and 
+  addressing_mode (0: horizontal, 2: page) are restored, so that 
+  U8X8_MSG_DISPLAY_DRAW_TILE still works.
+  Returns 0 if the area is not inside the 128 columns of the controller RAM 
+  or if it has less than 4 rows: the window commands would cost more than
+  the page addresses of U8X8_MSG_DISPLAY_DRAW_TILE.
+*/
+uint8_t u8x8_d_ssd13xx_draw_tile_area(u8x8_t *u8x8, uint8_t rows, u8x8_tile_t *tile, uint8_t addressing_mode)
+{
+  uint16_t x0, x1;
+  uint16_t offset;
+  uint8_t *ptr;
+  uint8_t is_full_window;
+  
+  x0 = tile->x_pos;
+  x0 *= 8;
+  x0 += u8x8->x_offset;
+  x1 = tile->cnt;
+  x1 *= 8;
+  x1 += x0;
+  if ( x1 > 128 || rows < 4 || tile->cnt == 0 )
+    return 0;
+  is_full_window = 0;
+  if ( x0 == 0 && x1 == 128 && tile->y_pos == 0 && rows == 8 )
+    is_full_window = 1;
+  
+  u8x8_cad_StartTransfer(u8x8);
+  u8x8_cad_SendCmd(u8x8, 0x040 | u8x8->display_start_line );	/* keep the line offset */
+  if ( addressing_mode != 0 )
+  {
+    u8x8_cad_SendCmd(u8x8, 0x020 );
+    u8x8_cad_SendArg(u8x8, 0x000 );	/* horizontal addressing mode */
+  }
+  u8x8_cad_SendCmd(u8x8, 0x021 );	/* column window, this also sets the column address */
+  u8x8_cad_SendArg(u8x8, x0 );
+  u8x8_cad_SendArg(u8x8, x1-1 );
+  u8x8_cad_SendCmd(u8x8, 0x022 );	/* page window, this also sets the page address */
+  u8x8_cad_SendArg(u8x8, tile->y_pos );
+  u8x8_cad_SendArg(u8x8, tile->y_pos + rows - 1 );
+  
+  offset = u8x8->display_info->tile_width;
+  offset *= 8;
+  ptr = tile->tile_ptr;
+  do
+  {
+    u8x8_cad_SendData(u8x8, tile->cnt*8, ptr); 	/* note: SendData can not handle more than 255 bytes */
+    ptr += offset;
+    rows--;
+  } while( rows > 0 );
+  
+  if ( is_full_window == 0 )
+  {
+    u8x8_cad_SendCmd(u8x8, 0x021 );
+    u8x8_cad_SendArg(u8x8, 0 );
+    u8x8_cad_SendArg(u8x8, 127 );
+    u8x8_cad_SendCmd(u8x8, 0x022 );
+    u8x8_cad_SendArg(u8x8, 0 );
+    u8x8_cad_SendArg(u8x8, 7 );
+  }
+  if ( addressing_mode != 0 )
+  {
+    u8x8_cad_SendCmd(u8x8, 0x020 );
+    u8x8_cad_SendArg(u8x8, addressing_mode );
+  }
+  u8x8_cad_EndTransfer(u8x8);
+  return 1;
+}
+
 static const u8x8_display_info_t u8x8_ssd1306_128x64_noname_display_info =
 {
   /* chip_enable_level = */ 0,
@@ -364,6 +447,8 @@ uint8_t u8x8_d_ssd1306_128x64_noname(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
   
   switch(msg)
   {
+    case U8X8_MSG_DISPLAY_DRAW_TILE_AREA:
+      return u8x8_d_ssd13xx_draw_tile_area(u8x8, arg_int, (u8x8_tile_t *)arg_ptr, 0);
     case U8X8_MSG_DISPLAY_INIT:
       u8x8_d_helper_display_init(u8x8);
       u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1306_128x64_noname_init_seq);    
@@ -401,8 +486,7 @@ uint8_t u8x8_d_ssd1312_128x64_noname(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
       u8x8_d_helper_display_setup_memory(u8x8, &u8x8_ssd1306_128x64_noname_display_info);
       break;
     default:
-      if ( u8x8_d_ssd1306_sh1106_generic(u8x8, msg, arg_int, arg_ptr) != 0 )
-        return 1;
+      return u8x8_d_ssd1306_sh1106_generic(u8x8, msg, arg_int, arg_ptr);
   }
   return 1;
 }
@@ -417,6 +501,8 @@ uint8_t u8x8_d_ssd1306_128x64_vcomh0(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
   
   switch(msg)
   {
+    case U8X8_MSG_DISPLAY_DRAW_TILE_AREA:
+      return u8x8_d_ssd13xx_draw_tile_area(u8x8, arg_int, (u8x8_tile_t *)arg_ptr, 0);
     case U8X8_MSG_DISPLAY_INIT:
       u8x8_d_helper_display_init(u8x8);
       u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1306_128x64_vcomh0_init_seq);    
@@ -438,6 +524,8 @@ uint8_t u8x8_d_ssd1306_128x64_alt0(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, v
   
   switch(msg)
   {
+    case U8X8_MSG_DISPLAY_DRAW_TILE_AREA:
+      return u8x8_d_ssd13xx_draw_tile_area(u8x8, arg_int, (u8x8_tile_t *)arg_ptr, 0);
     case U8X8_MSG_DISPLAY_INIT:
       u8x8_d_helper_display_init(u8x8);
       u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1306_128x64_alt0_init_seq);    
@@ -120,6 +120,35 @@ static uint8_t u8x8_d_ssd1309_generic(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int
       u8x8_cad_EndTransfer(u8x8);
       break;
 #endif
+    case U8X8_MSG_DISPLAY_SET_START_LINE:
+      u8x8->display_start_line = arg_int & 63;
+      u8x8_cad_StartTransfer(u8x8);
+      u8x8_cad_SendCmd(u8x8, 0x040 | u8x8->display_start_line );
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+    case U8X8_MSG_DISPLAY_SET_PIXEL_MODE:
+      u8x8_cad_StartTransfer(u8x8);
+      u8x8_cad_SendCmd(u8x8, (arg_int & U8X8_PIXEL_MODE_INVERSE) ? 0x0a7 : 0x0a6 );	/* inverse display */
+      u8x8_cad_SendCmd(u8x8, (arg_int & U8X8_PIXEL_MODE_ALL_ON) ? 0x0a5 : 0x0a4 );	/* entire display on */
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+    case U8X8_MSG_DISPLAY_SCROLL_COLUMN:
+      if ( arg_int == U8X8_SCROLL_COLUMN_CHECK )
+	break;
+      x = u8x8->x_offset;
+      u8x8_cad_StartTransfer(u8x8);
+      u8x8_cad_SendCmd(u8x8, arg_int == U8X8_SCROLL_COLUMN_RIGHT ? 0x02c : 0x02d );	/* one column content scroll */
+      u8x8_cad_SendArg(u8x8, 0x000 );
+      u8x8_cad_SendArg(u8x8, 0x000 );	/* start page */
+      u8x8_cad_SendArg(u8x8, 0x001 );
+      u8x8_cad_SendArg(u8x8, u8x8->display_info->tile_height - 1 );	/* end page */
+      u8x8_cad_SendArg(u8x8, 0x000 );
+      u8x8_cad_SendArg(u8x8, x );	/* start column */
+      u8x8_cad_SendArg(u8x8, x + u8x8->display_info->pixel_width - 1 );	/* end column */
+      u8x8_cad_EndTransfer(u8x8);
+      /* the RAM is moved with the next frame of the controller (about 100 Hz) */
+      u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_MILLI, 12);
+      break;
     default:
       return 0;
   }
@@ -200,6 +229,8 @@ uint8_t u8x8_d_ssd1309_128x64_noname2(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int
   
   switch(msg)
   {
+    case U8X8_MSG_DISPLAY_DRAW_TILE_AREA:
+      return u8x8_d_ssd13xx_draw_tile_area(u8x8, arg_int, (u8x8_tile_t *)arg_ptr, 2);
     case U8X8_MSG_DISPLAY_SET_FLIP_MODE:
       if ( arg_int == 0 )
       {
@@ -262,6 +293,8 @@ uint8_t u8x8_d_ssd1309_128x64_noname0(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int
   
   switch(msg)
   {
+    case U8X8_MSG_DISPLAY_DRAW_TILE_AREA:
+      return u8x8_d_ssd13xx_draw_tile_area(u8x8, arg_int, (u8x8_tile_t *)arg_ptr, 2);
     case U8X8_MSG_DISPLAY_SET_FLIP_MODE:
       if ( arg_int == 0 )
       {
@@ -131,6 +131,7 @@ static uint8_t u8x8_d_ssd1327_96x96_generic(u8x8_t *u8x8, uint8_t msg, uint8_t a
 {
   uint8_t x, y, c;
   uint8_t *ptr;
+  u8x8_gray_area_t *area;
   switch(msg)
   {
     /* handled by the calling function
@@ -194,6 +195,39 @@ static uint8_t u8x8_d_ssd1327_96x96_generic(u8x8_t *u8x8, uint8_t msg, uint8_t a
 	arg_int--;
       } while( arg_int > 0 );
       
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+    case U8X8_MSG_DISPLAY_SET_PIXEL_MODE:
+      /* 0x0a4..0x0a7 is one display mode: normal, all on, all off, inverse */
+      u8x8_cad_StartTransfer(u8x8);
+      if ( arg_int & U8X8_PIXEL_MODE_ALL_ON )
+	u8x8_cad_SendCmd(u8x8, 0x0a5 );
+      else if ( arg_int & U8X8_PIXEL_MODE_INVERSE )
+	u8x8_cad_SendCmd(u8x8, 0x0a7 );
+      else
+	u8x8_cad_SendCmd(u8x8, 0x0a4 );
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+    case U8X8_MSG_DISPLAY_DRAW_GRAY_AREA:
+      /* the RAM has the same layout as the area: one window, rows are written one after the other */
+      area = (u8x8_gray_area_t *)arg_ptr;
+      x = area->x_pos;
+      x += u8x8->x_offset/2;
+      y = area->y_pos;
+      u8x8_cad_StartTransfer(u8x8);
+      u8x8_cad_SendCmd(u8x8, 0x015 );	/* set column address */
+      u8x8_cad_SendArg(u8x8, x );
+      u8x8_cad_SendArg(u8x8, x + area->cnt - 1 );
+      u8x8_cad_SendCmd(u8x8, 0x075 );	/* set row address */
+      u8x8_cad_SendArg(u8x8, y );
+      u8x8_cad_SendArg(u8x8, y + arg_int - 1 );
+      ptr = area->ptr;
+      do
+      {
+	u8x8_cad_SendData(u8x8, area->cnt, ptr);
+	ptr += area->stride;
+	arg_int--;
+      } while( arg_int > 0 );
       u8x8_cad_EndTransfer(u8x8);
       break;
     default:
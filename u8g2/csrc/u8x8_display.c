@@ -66,6 +66,7 @@ void u8x8_d_helper_display_init(u8x8_t *u8x8)
       /* 2) apply port directions to the GPIO lines and apply default values for the IO lines*/
       u8x8_gpio_Init(u8x8);
       u8x8_cad_Init(u8x8);              /* this will also call U8X8_MSG_BYTE_INIT, byte init will NOT call GPIO_INIT */
+      u8x8->display_start_line = 0;	/* the init sequence will reset the start line */
 
       /* 3) do reset */
       u8x8_gpio_SetReset(u8x8, 1);
@@ -89,6 +90,37 @@ uint8_t u8x8_DrawTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *
   return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, 1, (void *)&tile);
 }
 
+/* 
+  draw a rectangle of "rows" tile rows with "cnt" tiles each, rows are 8*tile_width bytes apart (u8g2 buffer layout)
+  the display may send the whole area at once, otherwise each row is sent with u8x8_DrawTile()
+*/
+uint8_t u8x8_DrawTileArea(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *tile_ptr)
+{
+  u8x8_tile_t tile;
+  uint16_t offset;
+  
+  if ( rows > 1 )
+  {
+    tile.x_pos = x;
+    tile.y_pos = y;
+    tile.cnt = cnt;
+    tile.tile_ptr = tile_ptr;
+    if ( u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE_AREA, rows, (void *)&tile) != 0 )
+      return 1;
+  }
+  
+  offset = u8x8->display_info->tile_width;
+  offset *= 8;
+  while( rows > 0 )
+  {
+    u8x8_DrawTile(u8x8, x, y, cnt, tile_ptr);
+    tile_ptr += offset;
+    y++;
+    rows--;
+  }
+  return 1;
+}
+
 /* should be implemented as macro */
 void u8x8_SetupMemory(u8x8_t *u8x8)
 {
@@ -153,6 +185,21 @@ void u8x8_SetContrast(u8x8_t *u8x8, uint8_t value)
   u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SET_CONTRAST, value, NULL);  
 }
 
+uint8_t u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line)
+{
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SET_START_LINE, line, NULL);  
+}
+
+uint8_t u8x8_SetPixelMode(u8x8_t *u8x8, uint8_t mode)
+{
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SET_PIXEL_MODE, mode, NULL);  
+}
+
+uint8_t u8x8_ScrollDisplayColumn(u8x8_t *u8x8, uint8_t dir)
+{
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SCROLL_COLUMN, dir, NULL);  
+}
+
 void u8x8_RefreshDisplay(u8x8_t *u8x8)
 {
   u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_REFRESH, 0, NULL);  